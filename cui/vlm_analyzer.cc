@@ -4,6 +4,7 @@
 #include <boost/program_options.hpp>
 
 #include "VLMAnalyzer.h"
+#include "VLMResultCache.h"
 #include "SGFParser.h"
 
 using namespace std;
@@ -24,7 +25,13 @@ int main(int argc, char* argv[])
     ("pos", value<string>(), "POS形式ファイル名")
     ("depth,d", value<VLMSearchDepth>()->default_value(7), "探索深さ(四手五連:5, 五手五連:7)")
     ("dual", "余詰/最善応手を探索する")
+    ("dual-thread", value<size_t>()->default_value(1), "余詰判定で詰む手の証明木を並行して取得するthread数(default: 1)")
+    ("no-relevance-zone", "影響領域によるAND nodeの枝刈りを行わない")
+    ("record-proof", "探索中に詰む手, 防手を記録し、記録から証明木を取得する")
+    ("shortest", "最短手順であることを保証して探索する")
     ("sgf-output", "探索結果をSGF形式で出力する")
+    ("progress", value<uint64_t>()->implicit_value(1000000), "探索の進捗をJSON Lines形式で標準エラー出力に出力する(各深さの終了時と指定ノード数ごと, default: 1000000)")
+    ("result-cache", value<string>(), "解図結果キャッシュのファイル名(対称な局面を含め、解図済の局面は探索しない)")
     ("help,h", "ヘルプを表示");
   
   variables_map arg_map;
@@ -59,17 +66,51 @@ int main(int argc, char* argv[])
 
   const auto search_depth = arg_map["depth"].as<VLMSearchDepth>();
 
-  VLMAnalyzer vlm_analyzer(board_sequence);
+  // 余詰判定を並行して行う場合は置換表のロック制御を行う
+  const auto dual_solution_thread = arg_map["dual-thread"].as<size_t>();
+  const bool lock_control = dual_solution_thread >= 2 ? kLockControl : kDefaultVLMTableLockFree;
+  VLMAnalyzer vlm_analyzer(board_sequence, lock_control);
   
   cerr << vlm_analyzer.GetSettingInfo() << endl;
 
   VLMSearch vlm_search;
   vlm_search.remain_depth = search_depth;
   vlm_search.detect_dual_solution = arg_map.count("dual");
+  vlm_search.relevance_zone_pruning = !arg_map.count("no-relevance-zone");
+  vlm_search.record_proof_tree = arg_map.count("record-proof");
+  vlm_search.shortest_solution = arg_map.count("shortest");
+  vlm_search.dual_solution_thread = dual_solution_thread;
+
+  if(arg_map.count("progress")){
+    const auto node_interval = arg_map["progress"].as<uint64_t>();
+
+    vlm_analyzer.SetProgressCallback([](const VLMProgress &progress){
+      cerr << GetVLMProgressJSON(progress, "") << endl;
+    }, node_interval);
+  }
+
+  shared_ptr<VLMResultCache> result_cache;
+
+  if(arg_map.count("result-cache")){
+    const auto cache_path = arg_map["result-cache"].as<string>();
+    result_cache = make_shared<VLMResultCache>(cache_path, kDefaultResultCacheEntryNum);
+
+    if(!result_cache->IsOpen()){
+      cerr << "Failed to open the result cache: " << cache_path << endl;
+      result_cache.reset();
+    }
+  }
 
   VLMResult vlm_result;
 
-  vlm_analyzer.Solve(vlm_search, &vlm_result);
+  // 解図結果キャッシュから取得できた場合は探索しない
+  if(!result_cache || !result_cache->Find(board_sequence, vlm_search, &vlm_result)){
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+    if(result_cache){
+      result_cache->Upsert(board_sequence, vlm_search, vlm_result);
+    }
+  }
 
   cout << VLMResultString(arg_map, board_sequence, vlm_analyzer, vlm_search, vlm_result);
 
@@ -88,6 +129,10 @@ string VLMResultString(const variables_map &arg_map, const MoveList &board_move_
 
     ss << "First Move: " << MoveString(vlm_result.proof_tree.GetTopNodeMove()) << endl;
 
+    if(vlm_search.shortest_solution){
+      ss << "Shortest: " << (vlm_result.shortest_solution ? "Proven" : "Unknown") << endl;
+    }
+
     if(vlm_search.detect_dual_solution){
       ss << "Best response: " << vlm_result.best_response.str() << endl;
     }else{
@@ -128,6 +173,10 @@ string VLMResultString(const variables_map &arg_map, const MoveList &board_move_
   // 探索深さ
   ss << "Depth: " << vlm_result.search_depth << endl;
 
+  if(arg_map.count("result-cache")){
+    ss << "ResultCache: " << (vlm_result.result_cached ? "Hit" : "Miss") << endl;
+  }
+
   const auto& search_manager = vlm_analyzer.GetSearchManager();
 
   // 探索ノード数
@@ -148,10 +197,23 @@ string VLMResultString(const variables_map &arg_map, const MoveList &board_move_
 
   ss << "Simulation: " << simulation_success_count << " / " << simulation_count << " (" << simulation_success_rate << " %)" << endl;
 
+  // 実績により省略したSimulation, 証明木取得
+  ss << "SimulationSkip: " << vlm_analyzer.GetSimulationSkipCount() << endl;
+  ss << "ProofTreeSkip: " << vlm_analyzer.GetProofTreeSkipCount() << endl;
+
+  // 影響領域による枝刈り
+  ss << "RelevanceZonePruned: " << vlm_analyzer.GetRelevanceZonePruneCount() << endl;
+
+  // 残り深さ2のAND nodeの防手の評価(置換表のみ / 指し手を設定)
+  ss << "DepthTwoGuard: " << vlm_analyzer.GetDepthTwoProbeCount() << " / " << vlm_analyzer.GetDepthTwoMoveCount() << endl;
+
   // 探索時間
   const auto search_time = search_manager.GetSearchTime();
   ss << "Time(s): " << search_time / 1000.0 << endl;
 
+  // 余詰判定の時間
+  ss << "DualSolutionTime(s): " << vlm_analyzer.GetDualSolutionTime() / 1000.0 << endl;
+
   // 探索速度
   if(search_time > 0){
     ss << "NPS: " << 1000 * node_count / search_time << endl;
@@ -0,0 +1,125 @@
+#include "GameRecordAnalyzer.h"
+
+using namespace std;
+using namespace boost;
+using namespace realcore;
+
+GameRecordAnalyzer::GameRecordAnalyzer(const MoveList &game_record, const size_t table_space)
+: game_record_(game_record), result_list_(game_record.size() + 1), next_ply_(0)
+{
+  // 同じ攻め側の局面を複数threadで解図するため置換表のロック制御を行う
+  for(size_t i=0; i<2; i++){
+    vlm_table_[i] = std::make_shared<VLMTable>(table_space, kLockControl);
+    vcf_table_[i] = std::make_shared<VCFTable>(kDefaultVCFTableSpace, kLockControl);
+  }
+}
+
+void GameRecordAnalyzer::Run(const size_t thread_num, const realcore::VLMSearch &vlm_search)
+{
+  assert(thread_num >= 1);
+
+  cerr << "Read: " << game_record_.size() << " moves" << endl;
+
+  thread_group thread_group;
+
+  for(size_t i=0; i<thread_num; i++){
+    thread_group.create_thread(bind(&GameRecordAnalyzer::VLMAnalyze, this, vlm_search));
+  }
+
+  thread_group.join_all();
+
+  for(size_t ply=0; ply<result_list_.size(); ply++){
+    Output(ply, result_list_[ply]);
+  }
+}
+
+void GameRecordAnalyzer::VLMAnalyze(const realcore::VLMSearch &vlm_search)
+{
+  // 手数順に解図する(先行する局面の探索結果が置換表に残るため)
+  for(size_t ply=next_ply_++; ply<result_list_.size(); ply=next_ply_++){
+    MoveList board_sequence;
+
+    for(size_t i=0; i<ply; i++){
+      board_sequence += game_record_[i];
+    }
+
+    GameRecordResult &result = result_list_[ply];
+    result.is_black_turn = board_sequence.IsBlackTurn();
+
+    if(!IsNonTerminateNormalSequence(board_sequence)){
+      boost::mutex::scoped_lock lock(mutex_cerr_);
+      cerr << "Skip: " << ply << " (not a non-terminal normal sequence)" << endl;
+      continue;
+    }
+
+    {
+      boost::mutex::scoped_lock lock(mutex_cerr_);
+      cerr << "Ply: " << ply << endl;
+    }
+
+    const size_t attacker_index = result.is_black_turn ? 0 : 1;
+    VLMAnalyzer vlm_analyzer(board_sequence, vlm_table_[attacker_index], vcf_table_[attacker_index]);
+
+    vlm_analyzer.Solve(vlm_search, &result.vlm_result);
+
+    const auto &search_manager = vlm_analyzer.GetSearchManager();
+    result.is_analyzed = true;
+    result.search_time = search_manager.GetSearchTime() / 1000.0;
+    result.node = search_manager.GetNode();
+  }
+}
+
+void GameRecordAnalyzer::OutputHeader()
+{
+  cout << "Ply,";
+  cout << "Move,";
+  cout << "Turn,";
+  cout << "Result,";
+  cout << "FirstMove,";
+  cout << "ProofTree,";
+  cout << "SearchedDepth,";
+  cout << "Time(sec),";
+  cout << "Nodes";
+  cout << endl;
+}
+
+void GameRecordAnalyzer::Output(const size_t ply, const GameRecordResult &result) const
+{
+  const VLMResult &vlm_result = result.vlm_result;
+  stringstream ss;
+
+  // Ply, Move(局面の直前の手), Turn(攻め側)
+  ss << ply << ",";
+  ss << (ply == 0 ? "" : MoveString(game_record_[ply - 1])) << ",";
+  ss << (result.is_black_turn ? "Black" : "White") << ",";
+
+  if(!result.is_analyzed){
+    ss << "Skipped,,,,,";
+    cout << ss.str() << endl;
+    return;
+  }
+
+  // Result
+  if(vlm_result.solved){
+    ss << "Solved";
+  }else if(vlm_result.disproved){
+    ss << "Disproved";
+  }else if(vlm_result.budget_exhausted){
+    ss << "BudgetExhausted";
+  }else{
+    ss << "Terminated";
+  }
+
+  ss << ",";
+
+  // FirstMove, ProofTree
+  ss << (vlm_result.solved ? MoveString(vlm_result.proof_tree.GetTopNodeMove()) : "") << ",";
+  ss << (vlm_result.solved ? vlm_result.proof_tree.str() : "") << ",";
+
+  // SearchedDepth, Time(sec), Nodes
+  ss << vlm_result.search_depth << ",";
+  ss << result.search_time << ",";
+  ss << result.node;
+
+  cout << ss.str() << endl;
+}
@@ -0,0 +1,63 @@
+#ifndef GAME_RECORD_ANALYZER_H
+#define GAME_RECORD_ANALYZER_H
+
+#include <array>
+#include <vector>
+#include <atomic>
+#include <boost/thread.hpp>
+
+#include "VLMAnalyzer.h"
+#include "VLMTranspositionTable.h"
+
+//! @brief 棋譜の各局面(初手からの各手数の局面)を解図する
+//! @note 置換表は攻め側(手番)ごとに1つずつ確保し、同じ攻め側の局面間で共有する(先行する局面の探索結果を後続の局面で再利用する)
+//! @note 置換表の値は攻め側から見た値のため、攻め側が異なる局面とは共有しない
+class GameRecordAnalyzer
+{
+  friend class GameRecordAnalyzerTest;
+
+public:
+  //! @param game_record 棋譜
+  //! @param table_space 置換表のサイズ[MB](攻め側ごとに確保する)
+  GameRecordAnalyzer(const realcore::MoveList &game_record, const size_t table_space);
+
+  //! @brief 各局面を並行して解図し、手数順に解図結果を出力する
+  //! @param thread_num 同時実行数
+  //! @param vlm_search 解図設定
+  void Run(const size_t thread_num, const realcore::VLMSearch &vlm_search);
+
+  //! @brief 解図結果のHeaderを出力する
+  static void OutputHeader();
+
+private:
+  //! @brief 1局面の解図結果
+  typedef struct structGameRecordResult
+  {
+    structGameRecordResult()
+    : is_black_turn(true), is_analyzed(false), search_time(0), node(0)
+    {
+    }
+
+    bool is_black_turn;               //!< 攻め側(局面の手番)が黒か
+    bool is_analyzed;                 //!< 解図したか(終端局面等は解図しない)
+    realcore::VLMResult vlm_result;   //!< 解図結果
+    double search_time;               //!< 探索時間[sec]
+    std::uint64_t node;               //!< 探索ノード数
+  }GameRecordResult;
+
+  //! @brief 未解図の局面を手数順に解図する
+  void VLMAnalyze(const realcore::VLMSearch &vlm_search);
+
+  //! @brief 解図結果を出力する
+  void Output(const size_t ply, const GameRecordResult &result) const;
+
+  realcore::MoveList game_record_;    //!< 棋譜
+  std::array<std::shared_ptr<realcore::VLMTable>, 2> vlm_table_;    //!< 置換表([0]: 黒の攻め, [1]: 白の攻め)
+  std::array<std::shared_ptr<realcore::VCFTable>, 2> vcf_table_;    //!< VCF探索用の置換表([0]: 黒の攻め, [1]: 白の攻め)
+  std::vector<GameRecordResult> result_list_;   //!< 手数 -> 解図結果
+  std::atomic<size_t> next_ply_;      //!< 次に解図する局面の手数
+
+  mutable boost::mutex mutex_cerr_;   //!< 標準エラー出力のmutex
+};
+
+#endif    // GAME_RECORD_ANALYZER_H
@@ -1,3 +1,5 @@
+#include <fstream>
+
 #include "ParallelVLMAnalyzer.h"
 
 using namespace std;
@@ -5,6 +7,7 @@ using namespace boost;
 using namespace realcore;
 
 ParallelVLMAnalyzer::ParallelVLMAnalyzer(const std::string &problem_db_path)
+: is_progress_output_(false), progress_interval_(0), certificate_dir_(""), move_ordering_stat_path_("")
 {
   const auto is_read = ReadCSV(problem_db_path, &problem_db_);
 
@@ -28,9 +31,14 @@ void ParallelVLMAnalyzer::Run(const size_t thread_num, const realcore::VLMSearch
 
   // 置換表を確保する
   vlm_table_list_.reserve(thread_num);
+  vcf_table_list_.reserve(thread_num);
   
+  // 余詰判定を並行して行う場合は置換表のロック制御を行う
+  const bool lock_control = vlm_search.dual_solution_thread >= 2 ? kLockControl : kLockFree;
+
   for(size_t i=0; i<thread_num; i++){
-    vlm_table_list_.emplace_back(std::make_shared<VLMTable>(kDefaultVLMTableSpace, kLockFree));
+    vlm_table_list_.emplace_back(std::make_shared<VLMTable>(kDefaultVLMTableSpace, lock_control));
+    vcf_table_list_.emplace_back(std::make_shared<VCFTable>(kDefaultVCFTableSpace, lock_control));
   }
 
   // VLM Analyzerの設定を出力
@@ -43,6 +51,26 @@ void ParallelVLMAnalyzer::Run(const size_t thread_num, const realcore::VLMSearch
   }
 
   thread_group.join_all();
+
+  if(!move_ordering_stat_path_.empty()){
+    OutputMoveOrderingStat();
+  }
+}
+
+void ParallelVLMAnalyzer::SetProgressInterval(const std::uint64_t node_interval)
+{
+  is_progress_output_ = true;
+  progress_interval_ = node_interval;
+}
+
+void ParallelVLMAnalyzer::SetDisproofCertificateDir(const std::string &certificate_dir)
+{
+  certificate_dir_ = certificate_dir;
+}
+
+void ParallelVLMAnalyzer::SetMoveOrderingStatPath(const std::string &stat_path)
+{
+  move_ordering_stat_path_ = stat_path;
 }
 
 const bool ParallelVLMAnalyzer::GetProblemIndex(size_t * const problem_index)
@@ -80,6 +108,7 @@ void ParallelVLMAnalyzer::VLMAnalyze(const size_t thread_id, const realcore::VLM
     const auto board_string = board_list[problem_id];
     MoveList board_sequence(board_string);
     const auto &vlm_table = vlm_table_list_[thread_id];
+    const auto &vcf_table = vcf_table_list_[thread_id];
 
     if(!IsNonTerminateNormalSequence(board_sequence)){
       boost::mutex::scoped_lock lock(mutex_cerr_);
@@ -96,12 +125,27 @@ void ParallelVLMAnalyzer::VLMAnalyze(const size_t thread_id, const realcore::VLM
     }
 
     vlm_table->Initialize();
+    vcf_table->Initialize();
 
-    VLMAnalyzer vlm_analyzer(board_sequence, vlm_table);
+    VLMAnalyzer vlm_analyzer(board_sequence, vlm_table, vcf_table);
     VLMResult vlm_result;
 
+    if(is_progress_output_){
+      const auto &problem_id_str = id_list[problem_id];
+
+      vlm_analyzer.SetProgressCallback([this, &problem_id_str](const VLMProgress &progress){
+        boost::mutex::scoped_lock lock(mutex_cerr_);
+        cerr << GetVLMProgressJSON(progress, problem_id_str) << endl;
+      }, progress_interval_);
+    }
+
     vlm_analyzer.Solve(vlm_search, &vlm_result);
     Output(problem_id, vlm_analyzer, vlm_search, vlm_result);
+    OutputDisproofCertificate(problem_id, vlm_result);
+
+    if(vlm_search.train_move_ordering){
+      AddMoveOrderingStat(vlm_analyzer);
+    }
 
     exist_problem = GetProblemIndex(&problem_id);
   }
@@ -122,12 +166,70 @@ void ParallelVLMAnalyzer::OutputHeader()
   cout << "GetProofTreeSuccessCount,";
   cout << "SimulationCount,";
   cout << "SimulationSuccessCount,";
+  cout << "RelevanceZonePruned,";
+  cout << "Refutations,";
+  cout << "NodesPerRefutation,";
+  cout << "MovesPerRefutation,";
   cout << "Time(sec),";
+  cout << "DualSolutionTime(sec),";
   cout << "Nodes,";
   cout << "NPS";
   cout << endl;
 }
 
+void ParallelVLMAnalyzer::OutputDisproofCertificate(const size_t problem_id, const realcore::VLMResult &vlm_result) const
+{
+  if(certificate_dir_.empty() || vlm_result.disproof_certificate.empty()){
+    return;
+  }
+
+  const StringVector &id_list = problem_db_.at("ID");
+  const auto certificate_path = certificate_dir_ + "/" + id_list[problem_id] + ".vlmd";
+
+  ofstream ofs(certificate_path, ios::binary);
+  ofs.write(vlm_result.disproof_certificate.data(), vlm_result.disproof_certificate.size());
+
+  if(!ofs){
+    boost::mutex::scoped_lock lock(mutex_cerr_);
+    cerr << "Failed to write the disproof certificate: " << certificate_path << endl;
+  }
+}
+
+void ParallelVLMAnalyzer::AddMoveOrderingStat(const realcore::VLMAnalyzer &vlm_analyzer)
+{
+  boost::mutex::scoped_lock lock(mutex_move_ordering_stat_);
+
+  for(size_t node=0; node<kMoveOrderingNodeNum; node++){
+    const auto &stat_table = vlm_analyzer.GetMoveOrderingStat(static_cast<MoveOrderingNode>(node));
+
+    for(size_t category=0; category<kMoveOrderingCategoryNum; category++){
+      move_ordering_stat_[node][category].candidate_count += stat_table[category].candidate_count;
+      move_ordering_stat_[node][category].selected_count += stat_table[category].selected_count;
+    }
+  }
+}
+
+void ParallelVLMAnalyzer::OutputMoveOrderingStat() const
+{
+  ofstream ofs(move_ordering_stat_path_);
+  ofs << "Node,Category,Candidates,Selected" << endl;
+
+  for(size_t node=0; node<kMoveOrderingNodeNum; node++){
+    for(size_t category=0; category<kMoveOrderingCategoryNum; category++){
+      const auto &stat = move_ordering_stat_[node][category];
+
+      ofs << kMoveOrderingNodeName[node] << ",";
+      ofs << kMoveOrderingCategoryName[category] << ",";
+      ofs << stat.candidate_count << ",";
+      ofs << stat.selected_count << endl;
+    }
+  }
+
+  if(!ofs){
+    cerr << "Failed to write the move ordering stat: " << move_ordering_stat_path_ << endl;
+  }
+}
+
 void ParallelVLMAnalyzer::Output(const size_t problem_id, const realcore::VLMAnalyzer &vlm_analyzer, const realcore::VLMSearch &vlm_search, const realcore::VLMResult &vlm_result) const
 {
   const StringVector &id_list = problem_db_.at("ID");
@@ -146,6 +248,8 @@ void ParallelVLMAnalyzer::Output(const size_t problem_id, const realcore::VLMAna
     ss << "Solved";
   }else if(vlm_result.disproved){
     ss << "Disproved";
+  }else if(vlm_result.budget_exhausted){
+    ss << "BudgetExhausted";
   }else{
     ss << "Terminated";
   }
@@ -197,10 +301,27 @@ void ParallelVLMAnalyzer::Output(const size_t problem_id, const realcore::VLMAna
   ss << simulation_count << ",";
   ss << simulation_success_count << ",";
 
+  // 影響領域による枝刈り
+  ss << vlm_analyzer.GetRelevanceZonePruneCount() << ",";
+
+  // 詰みを防ぐ防手が見つかるまでの探索ノード数, 展開した防手の数(AND nodeあたり)
+  const auto refutation_count = vlm_analyzer.GetRefutationCount();
+  ss << refutation_count << ",";
+
+  if(refutation_count > 0){
+    ss << static_cast<double>(vlm_analyzer.GetRefutationNode()) / refutation_count << ",";
+    ss << static_cast<double>(vlm_analyzer.GetRefutationMoveCount()) / refutation_count << ",";
+  }else{
+    ss << "-,-,";
+  }
+
   // Time(sec)
   const auto search_time = search_manager.GetSearchTime() / 1000.0;
   ss << search_time << ",";
 
+  // 余詰判定の時間(sec)
+  ss << vlm_analyzer.GetDualSolutionTime() / 1000.0 << ",";
+
   // 探索ノード数
   const auto node_count = search_manager.GetNode();
   ss << node_count << ",";
@@ -19,6 +19,18 @@ public:
   //! @param vlm_search 解図設定
   void Run(const size_t thread_num, const realcore::VLMSearch &vlm_search);
 
+  //! @brief 探索の進捗をJSON Lines形式で標準エラー出力に出力する
+  //! @param node_interval 出力するノード数の間隔(0: 各深さの終了時のみ出力する)
+  void SetProgressInterval(const std::uint64_t node_interval);
+
+  //! @brief 強意の不詰となった問題の不詰の証明書を出力する
+  //! @param certificate_dir 出力先のディレクトリ(ファイル名: <ID>.vlmd)
+  void SetDisproofCertificateDir(const std::string &certificate_dir);
+
+  //! @brief 指し手の順序付けの区分の実績を全問題で集計し、解図終了時にCSVで出力する
+  //! @param stat_path 出力先のファイルパス(cui_batch/generate_move_ordering_table.pyの入力)
+  void SetMoveOrderingStatPath(const std::string &stat_path);
+
   //! @brief 解図結果のHeaderを出力する
   static void OutputHeader();
 private:
@@ -30,6 +42,15 @@ private:
   //! @retval true 問題indexを取得, false 問題indexのリストが空
   const bool GetProblemIndex(size_t * const problem_index);
 
+  //! @brief 不詰の証明書をファイルに出力する
+  void OutputDisproofCertificate(const size_t problem_id, const realcore::VLMResult &vlm_result) const;
+
+  //! @brief 指し手の順序付けの区分の実績を加算する
+  void AddMoveOrderingStat(const realcore::VLMAnalyzer &vlm_analyzer);
+
+  //! @brief 指し手の順序付けの区分の実績を出力する
+  void OutputMoveOrderingStat() const;
+
   //! @brief 解図結果を出力する
   void Output(const size_t problem_id, const realcore::VLMAnalyzer &vlm_analyzer, const realcore::VLMSearch &vlm_search, const realcore::VLMResult &vlm_result) const;
   
@@ -37,10 +58,18 @@ private:
   std::deque<size_t> problem_index_list_;    //!< 問題indexのリスト
   std::map<std::string, realcore::StringVector> problem_db_;   //!< VLM問題DB
   std::vector< std::shared_ptr<realcore::VLMTable> > vlm_table_list_;   //!< 置換表(thread分確保する)
+  std::vector< std::shared_ptr<realcore::VCFTable> > vcf_table_list_;   //!< VCF探索用の置換表(thread分確保する)
+
+  bool is_progress_output_;           //!< 探索の進捗を出力するか
+  std::uint64_t progress_interval_;   //!< 探索の進捗を出力するノード数の間隔
+  std::string certificate_dir_;       //!< 不詰の証明書の出力先(空の場合は出力しない)
+  std::string move_ordering_stat_path_;   //!< 指し手の順序付けの区分の実績の出力先(空の場合は出力しない)
+  std::array<realcore::MoveOrderingStatTable, realcore::kMoveOrderingNodeNum> move_ordering_stat_;   //!< 全問題の順序付けの区分の実績
 
   mutable boost::mutex mutex_cout_;   //!< 標準出力のmutex
   mutable boost::mutex mutex_cerr_;   //!< 標準エラー出力のmutex
   mutable boost::mutex mutex_problem_index_list_;   //!< problem_index_list_のmutex
+  mutable boost::mutex mutex_move_ordering_stat_;   //!< move_ordering_stat_のmutex
 };
 
 #endif    // PARALELLE_VLM_ANALYZER_H
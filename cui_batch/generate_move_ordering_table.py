@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# vlm_analyzer_batch --train-orderingの集計結果から指し手の順序付けの優先度表(VLMMoveOrderingTable.h)を生成する
+import sys
+import csv
+
+# VLMMoveOrdering.hのMoveOrderingCategoryと同一の順序
+CATEGORY_LIST = ['FourThree', 'DoubleThree', 'ThreatSword', 'ThreatMise', 'MultiMise', 'MiseSword',
+                 'Mise', 'Sword', 'Two', 'Four', 'Three', 'OpponentFour']
+
+# VLMMoveOrdering.hのMoveOrderingNodeと同一の順序
+NODE_LIST = ['ORBlack', 'ORWhite', 'ANDBlack', 'ANDWhite']
+
+# 優先度表に含める区分の最小の候補手数(実績の少ない区分は優先しない)
+MIN_CANDIDATE_COUNT = 100
+
+HEADER_TEMPLATE = '''//! @file
+//! @brief 指し手の順序付けの優先度表
+//! @note cui_batch/generate_move_ordering_table.pyで生成する(vlm_analyzer_batch --train-orderingの学習結果から再生成できる)
+//! @note 学習結果: %s
+#ifndef VLM_MOVE_ORDERING_TABLE_H
+#define VLM_MOVE_ORDERING_TABLE_H
+
+#include "VLMMoveOrdering.h"
+
+namespace realcore{
+%s
+}   // namespace realcore
+
+#endif    // VLM_MOVE_ORDERING_TABLE_H
+'''
+
+
+def get_ordering_table(stat_list):
+    # 候補手のうち詰む手(詰みを防ぐ手)となった割合の高い区分から優先する
+    ordering = []
+
+    for category in CATEGORY_LIST:
+        candidate_count, selected_count = stat_list.get(category, (0, 0))
+
+        if candidate_count < MIN_CANDIDATE_COUNT or selected_count == 0:
+            continue
+
+        ordering.append((float(selected_count) / candidate_count, category))
+
+    ordering.sort(key=lambda x: -x[0])   # 同率の場合は区分の定義順(安定ソート)
+    return [category for rate, category in ordering]
+
+
+if __name__ == "__main__":
+    argvs = sys.argv
+    argc = len(argvs)
+
+    if(argc != 3):
+        print('Usage %s (move ordering stat csv) (output header file)' % argvs[0])
+        quit()
+
+    stat_filename = argvs[1]
+    stat_dict = {}
+
+    with open(stat_filename, 'r') as stat_file:
+        for row in csv.DictReader(stat_file):
+            node_stat = stat_dict.setdefault(row['Node'], {})
+            node_stat[row['Category']] = (int(row['Candidates']), int(row['Selected']))
+
+    table_list = []
+
+    for node in NODE_LIST:
+        ordering = get_ordering_table(stat_dict.get(node, {}))
+        entry_list = ['kOrdering' + category for category in ordering]
+
+        if len(entry_list) < len(CATEGORY_LIST):
+            entry_list.append('kOrderingNone')
+
+        line_list = [', '.join(entry_list[i:i + 5]) for i in range(0, len(entry_list), 5)]
+        table_list.append('\nconstexpr MoveOrderingTable kMoveOrdering%s = {{\n  %s\n}};\n' % (node, ',\n  '.join(line_list)))
+
+    with open(argvs[2], 'w') as header_file:
+        header_file.write(HEADER_TEMPLATE % (stat_filename, ''.join(table_list)))
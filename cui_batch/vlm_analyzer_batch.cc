@@ -1,9 +1,14 @@
 #include <iostream>
 #include <chrono>
+#include <fstream>
+#include <iterator>
 
 #include <boost/program_options.hpp>
 
 #include "ParallelVLMAnalyzer.h"
+#include "GameRecordAnalyzer.h"
+#include "SGFParser.h"
+#include "VLMProofVerifier.h"
 
 using namespace std;
 using namespace boost::program_options;
@@ -11,6 +16,11 @@ using namespace realcore;
 
 string VLMResultString(const VLMAnalyzer &vlm_analyzer, const VLMResult &vlm_result);
 
+//! @brief 解図結果CSVのProofTree列の証明木を検証し、結果を出力する
+//! @param thread_num 1問の証明木の部分木を並行して検証するthread数
+//! @param certificate_dir 不詰の証明書のディレクトリ(空でない場合はDisprovedの問題の証明書も検証する)
+int VerifyResultCSV(const string &result_csv_path, const size_t thread_num, const string &certificate_dir);
+
 int main(int argc, char* argv[])
 {
   // オプション設定
@@ -20,38 +30,161 @@ int main(int argc, char* argv[])
     ("problem-db,p", value<string>(), "問題DBのファイルパス")
     ("depth,d", value<VLMSearchDepth>()->default_value(7), "探索深さ(default: 7)")
     ("dual", "余詰を探索する")
+    ("dual-thread", value<size_t>()->default_value(1), "1問の余詰判定で詰む手の証明木を並行して取得するthread数(default: 1)")
+    ("no-relevance-zone", "影響領域によるAND nodeの枝刈りを行わない")
+    ("threat-ordering", "AND nodeの防手を攻め側の脅威の推定値で順序付けする")
+    ("train-ordering", value<string>(), "詰む手, 詰みを防ぐ手の順序付けの区分の実績を集計してCSVに出力する(generate_move_ordering_table.pyの入力)")
+    ("time-limit", value<double>()->default_value(0), "1問あたりの探索時間の上限[sec](default: 0(上限なし))")
+    ("node-limit", value<uint64_t>()->default_value(0), "1問あたりの探索ノード数の上限(default: 0(上限なし))")
     ("thread", value<size_t>()->default_value(1), "同時実行数(default: 1)")
+    ("progress", value<uint64_t>()->implicit_value(1000000), "探索の進捗をJSON Lines形式で標準エラー出力に出力する(各深さの終了時と指定ノード数ごと, default: 1000000)")
+    ("game-sgf", value<string>(), "SGF形式の棋譜の各局面を解図する(置換表を局面間で共有する)")
+    ("game-pos", value<string>(), "POS形式ファイルの棋譜の各局面を解図する(置換表を局面間で共有する)")
+    ("verify", value<string>(), "解図結果CSV(Board, Result, ProofTree列)の証明木を探索を行わずに検証する")
+    ("disproof-cert", value<string>(), "強意の不詰となった問題の不詰の証明書(<ID>.vlmd)を出力するディレクトリ(--verify指定時は証明書を検証する)")
     ("header", "ヘッダを表示")
     ("help,h", "ヘルプを表示");
   
   variables_map arg_map;
   store(parse_command_line(argc, argv, option), arg_map);
 
-  if(arg_map.count("header")){
+  const bool is_game_record = arg_map.count("game-sgf") || arg_map.count("game-pos");
+
+  if(arg_map.count("header") && !is_game_record){
     ParallelVLMAnalyzer::OutputHeader();
     return 0;
   }
 
-  bool is_help = arg_map.count("help") || !arg_map.count("problem-db");
+  const string certificate_dir = arg_map.count("disproof-cert") ? arg_map["disproof-cert"].as<string>() : "";
+
+  if(arg_map.count("verify")){
+    return VerifyResultCSV(arg_map["verify"].as<string>(), arg_map["thread"].as<size_t>(), certificate_dir);
+  }
+
+  bool is_help = arg_map.count("help") || (!arg_map.count("problem-db") && !is_game_record);
 
   if(is_help){
     cout << "Usage: " << argv[0] << " [options]" << endl;
     cout << option;
     cout << "Note: problem-db must have ID, Name, Board column" << endl;
+    cout << "Note: game-sgf, game-pos output one row per ply of the game record" << endl;
     cout << endl;
     return 0;
   }
 
-  const auto problem_db_path = arg_map["problem-db"].as<string>();
-  ParallelVLMAnalyzer parallel_vlm_analyzer(problem_db_path);
-
   const auto thread_num = arg_map["thread"].as<size_t>();
   
   VLMSearch vlm_search;
   vlm_search.remain_depth = arg_map["depth"].as<VLMSearchDepth>();
   vlm_search.detect_dual_solution = arg_map.count("dual");
+  vlm_search.relevance_zone_pruning = !arg_map.count("no-relevance-zone");
+  vlm_search.threat_move_ordering = arg_map.count("threat-ordering");
+  vlm_search.train_move_ordering = arg_map.count("train-ordering");
+  vlm_search.dual_solution_thread = arg_map["dual-thread"].as<size_t>();
+  vlm_search.time_limit = static_cast<uint64_t>(arg_map["time-limit"].as<double>() * 1000);
+  vlm_search.node_limit = arg_map["node-limit"].as<uint64_t>();
+  vlm_search.disproof_certificate = !certificate_dir.empty();
+
+  if(is_game_record){
+    MoveList game_record;
+    const bool is_read = arg_map.count("game-sgf") ? GetMoveListFromSGFData(kSGFCheckNone, arg_map["game-sgf"].as<string>(), &game_record) : ReadPOSFile(arg_map["game-pos"].as<string>(), &game_record);
+
+    if(!is_read){
+      cerr << "Failed to read the game record: " << (arg_map.count("game-sgf") ? arg_map["game-sgf"].as<string>() : arg_map["game-pos"].as<string>()) << endl;
+      return 1;
+    }
+
+    // 棋譜の解図結果は手数順に出力するためヘッダを先頭に出力する
+    if(arg_map.count("header")){
+      GameRecordAnalyzer::OutputHeader();
+    }
+
+    // 攻め側ごとに置換表を確保するため、合計が1問の解図と同じサイズになるよう半分ずつ確保する
+    GameRecordAnalyzer game_record_analyzer(game_record, kDefaultVLMTableSpace / 2);
+    game_record_analyzer.Run(thread_num, vlm_search);
+
+    return 0;
+  }
+
+  const auto problem_db_path = arg_map["problem-db"].as<string>();
+  ParallelVLMAnalyzer parallel_vlm_analyzer(problem_db_path);
+
+  if(arg_map.count("progress")){
+    parallel_vlm_analyzer.SetProgressInterval(arg_map["progress"].as<uint64_t>());
+  }
+
+  if(!certificate_dir.empty()){
+    parallel_vlm_analyzer.SetDisproofCertificateDir(certificate_dir);
+  }
+
+  if(arg_map.count("train-ordering")){
+    parallel_vlm_analyzer.SetMoveOrderingStatPath(arg_map["train-ordering"].as<string>());
+  }
 
   parallel_vlm_analyzer.Run(thread_num, vlm_search);
 
   return 0;
 }
+
+int VerifyResultCSV(const string &result_csv_path, const size_t thread_num, const string &certificate_dir)
+{
+  map<string, StringVector> result_db;
+
+  if(!ReadCSV(result_csv_path, &result_db)){
+    cerr << "Failed to read the result csv: " << result_csv_path << endl;
+    return 1;
+  }
+
+  for(const auto &column : {"ID", "Board", "Result", "ProofTree"}){
+    if(result_db.find(column) == result_db.end()){
+      cerr << "The result csv must have " << column << " column" << endl;
+      return 1;
+    }
+  }
+
+  const StringVector &id_list = result_db.at("ID");
+  const StringVector &board_list = result_db.at("Board");
+  const StringVector &result_list = result_db.at("Result");
+  const StringVector &proof_tree_list = result_db.at("ProofTree");
+
+  size_t verified_count = 0, failed_count = 0;
+  cout << "ID,Verified" << endl;
+
+  for(size_t i=0; i<board_list.size(); i++){
+    const bool is_solved = result_list[i] == "Solved";
+    const bool is_disproved = result_list[i] == "Disproved" && !certificate_dir.empty();
+
+    if(!is_solved && !is_disproved){
+      continue;
+    }
+
+    const VLMProofVerifier proof_verifier((MoveList(board_list[i])));
+    bool is_verified = false;
+
+    if(is_solved){
+      const MoveTree proof_tree(proof_tree_list[i]);
+      is_verified = proof_verifier.Verify(proof_tree, thread_num);
+    }else{
+      // 証明書がない問題(弱意の不詰など)は検証対象外とする
+      ifstream ifs(certificate_dir + "/" + id_list[i] + ".vlmd", ios::binary);
+
+      if(!ifs){
+        continue;
+      }
+
+      const string certificate((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+      is_verified = proof_verifier.VerifyDisproofCertificate(certificate);
+    }
+
+    cout << id_list[i] << "," << (is_verified ? "OK" : "NG") << endl;
+
+    if(is_verified){
+      verified_count++;
+    }else{
+      failed_count++;
+    }
+  }
+
+  cerr << "Verified: " << verified_count << ", Failed: " << failed_count << endl;
+  return failed_count == 0 ? 0 : 1;
+}
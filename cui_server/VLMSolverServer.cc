@@ -0,0 +1,266 @@
+#include <sstream>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "VLMSolverServer.h"
+
+using namespace std;
+using namespace boost;
+using namespace realcore;
+
+VLMSolverServer::VLMSolverServer(const size_t table_space)
+: is_input_end_(false), out_stream_(nullptr)
+{
+  // 複数の解図threadで同じ攻め側の局面を解図するため置換表のロック制御を行う
+  for(size_t i=0; i<2; i++){
+    vlm_table_[i] = std::make_shared<VLMTable>(table_space, kLockControl);
+    vcf_table_[i] = std::make_shared<VCFTable>(kDefaultVCFTableSpace, kLockControl);
+  }
+}
+
+void VLMSolverServer::SetResultCache(const std::shared_ptr<realcore::VLMResultCache> &result_cache)
+{
+  result_cache_ = result_cache;
+}
+
+void VLMSolverServer::Run(const size_t thread_num, const realcore::VLMSearch &vlm_search, std::istream &in_stream, std::ostream &out_stream)
+{
+  assert(thread_num >= 1);
+  out_stream_ = &out_stream;
+
+  thread_group thread_group;
+
+  for(size_t i=0; i<thread_num; i++){
+    thread_group.create_thread(bind(&VLMSolverServer::SolveWorker, this));
+  }
+
+  string request_line;
+
+  while(getline(in_stream, request_line)){
+    if(request_line.find_first_not_of(" \t\r") == string::npos){
+      continue;
+    }
+
+    SolveRequest request;
+    string error_message;
+    const bool is_parsed = ParseRequest(request_line, vlm_search, &request, &error_message);
+
+    if(!is_parsed){
+      stringstream ss;
+      ss << "{";
+
+      if(!request.id.empty()){
+        ss << "\"id\":\"" << EscapeJSONString(request.id) << "\",";
+      }
+
+      ss << "\"event\":\"error\",";
+      ss << "\"message\":\"" << EscapeJSONString(error_message) << "\"";
+      ss << "}";
+
+      OutputLine(ss.str());
+      continue;
+    }
+
+    boost::mutex::scoped_lock lock(mutex_request_queue_);
+    request_queue_.emplace_back(request);
+    request_cond_.notify_one();
+  }
+
+  {
+    boost::mutex::scoped_lock lock(mutex_request_queue_);
+    is_input_end_ = true;
+    request_cond_.notify_all();
+  }
+
+  thread_group.join_all();
+}
+
+const bool VLMSolverServer::ParseRequest(const std::string &request_line, const realcore::VLMSearch &default_search, SolveRequest * const request, std::string * const error_message)
+{
+  assert(request != nullptr);
+  assert(error_message != nullptr);
+
+  property_tree::ptree request_tree;
+
+  try{
+    stringstream ss(request_line);
+    property_tree::read_json(ss, request_tree);
+  }catch(const property_tree::json_parser_error &e){
+    *error_message = "invalid JSON: " + e.message();
+    return false;
+  }
+
+  request->id = request_tree.get<string>("id", "");
+
+  const auto board_string = request_tree.get_optional<string>("board");
+
+  if(!board_string){
+    *error_message = "board is required";
+    return false;
+  }
+
+  // [a-o]形式: 2文字で1手
+  const bool is_board_format = board_string->size() % 2 == 0 && board_string->find_first_not_of("abcdefghijklmno") == string::npos;
+
+  if(!is_board_format){
+    *error_message = "board must be a [a-o] move string";
+    return false;
+  }
+
+  request->board_sequence = MoveList(*board_string);
+
+  if(!IsNonTerminateNormalSequence(request->board_sequence)){
+    *error_message = "board is not a non-terminal normal sequence";
+    return false;
+  }
+
+  try{
+    VLMSearch &vlm_search = request->vlm_search;
+    vlm_search = default_search;
+
+    vlm_search.remain_depth = request_tree.get<VLMSearchDepth>("depth", default_search.remain_depth);
+    vlm_search.detect_dual_solution = request_tree.get<bool>("dual", default_search.detect_dual_solution);
+    vlm_search.node_limit = request_tree.get<uint64_t>("node_limit", default_search.node_limit);
+
+    const auto time_limit = request_tree.get_optional<double>("time_limit");
+
+    if(time_limit){
+      vlm_search.time_limit = static_cast<uint64_t>(*time_limit * 1000);
+    }
+
+    const auto progress_interval = request_tree.get_optional<uint64_t>("progress");
+
+    if(progress_interval){
+      request->is_progress_output = true;
+      request->progress_interval = *progress_interval;
+    }
+  }catch(const property_tree::ptree_bad_data &e){
+    *error_message = string("invalid parameter: ") + e.what();
+    return false;
+  }
+
+  if(request->vlm_search.remain_depth < 1 || request->vlm_search.remain_depth > static_cast<VLMSearchDepth>(kInBoardMoveNum)){
+    *error_message = "depth is out of range";
+    return false;
+  }
+
+  return true;
+}
+
+const bool VLMSolverServer::PopRequest(SolveRequest * const request)
+{
+  assert(request != nullptr);
+  boost::mutex::scoped_lock lock(mutex_request_queue_);
+
+  while(request_queue_.empty() && !is_input_end_){
+    request_cond_.wait(lock);
+  }
+
+  if(request_queue_.empty()){
+    return false;
+  }
+
+  *request = request_queue_.front();
+  request_queue_.pop_front();
+
+  return true;
+}
+
+void VLMSolverServer::SolveWorker()
+{
+  SolveRequest request;
+
+  while(PopRequest(&request)){
+    Solve(request);
+  }
+}
+
+void VLMSolverServer::Solve(const SolveRequest &request)
+{
+  const size_t attacker_index = request.board_sequence.IsBlackTurn() ? 0 : 1;
+  VLMAnalyzer vlm_analyzer(request.board_sequence, vlm_table_[attacker_index], vcf_table_[attacker_index]);
+
+  const string escaped_id = EscapeJSONString(request.id);
+
+  if(request.is_progress_output){
+    vlm_analyzer.SetProgressCallback([this, &request](const VLMProgress &progress){
+      OutputLine(GetVLMProgressJSON(progress, request.id));
+    }, request.progress_interval);
+  }
+
+  VLMResult vlm_result;
+
+  // 解図結果キャッシュから取得できた場合は探索しない
+  if(!result_cache_ || !result_cache_->Find(request.board_sequence, request.vlm_search, &vlm_result)){
+    vlm_analyzer.Solve(request.vlm_search, &vlm_result);
+
+    if(result_cache_){
+      result_cache_->Upsert(request.board_sequence, request.vlm_search, vlm_result);
+    }
+  }
+
+  stringstream ss;
+  ss << "{";
+
+  if(!escaped_id.empty()){
+    ss << "\"id\":\"" << escaped_id << "\",";
+  }
+
+  ss << "\"event\":\"result\",";
+
+  // Result
+  ss << "\"result\":\"";
+
+  if(vlm_result.solved){
+    ss << "Solved";
+  }else if(vlm_result.disproved){
+    ss << "Disproved";
+  }else if(vlm_result.budget_exhausted){
+    ss << "BudgetExhausted";
+  }else{
+    ss << "Terminated";
+  }
+
+  ss << "\",";
+
+  // 初手, 証明木
+  if(vlm_result.solved){
+    ss << "\"first_move\":\"" << MoveString(vlm_result.proof_tree.GetTopNodeMove()) << "\",";
+    ss << "\"proof_tree\":\"" << EscapeJSONString(vlm_result.proof_tree.str()) << "\",";
+  }else{
+    ss << "\"first_move\":null,";
+    ss << "\"proof_tree\":null,";
+  }
+
+  // 余詰, 最善応手(余詰判定を行った場合のみ)
+  if(vlm_result.solved && request.vlm_search.detect_dual_solution){
+    if(vlm_result.detect_dual_solution){
+      ss << "\"dual_solution\":\"" << EscapeJSONString(vlm_result.dual_solution_tree.str()) << "\",";
+    }else{
+      ss << "\"dual_solution\":\"\",";
+    }
+
+    ss << "\"best_response\":\"" << vlm_result.best_response.str() << "\",";
+  }else{
+    ss << "\"dual_solution\":null,";
+    ss << "\"best_response\":null,";
+  }
+
+  const auto &search_manager = vlm_analyzer.GetSearchManager();
+
+  ss << "\"depth\":" << vlm_result.search_depth << ",";
+  ss << "\"nodes\":" << search_manager.GetNode() << ",";
+  ss << "\"time_ms\":" << search_manager.GetSearchTime() << ",";
+  ss << "\"cached\":" << (vlm_result.result_cached ? "true" : "false");
+  ss << "}";
+
+  OutputLine(ss.str());
+}
+
+void VLMSolverServer::OutputLine(const std::string &line)
+{
+  boost::mutex::scoped_lock lock(mutex_out_stream_);
+
+  // 応答を待つクライアントのため1行ごとにflushする
+  *out_stream_ << line << endl;
+}
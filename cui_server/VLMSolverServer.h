@@ -0,0 +1,86 @@
+#ifndef VLM_SOLVER_SERVER_H
+#define VLM_SOLVER_SERVER_H
+
+#include <array>
+#include <deque>
+#include <string>
+#include <iostream>
+#include <boost/thread.hpp>
+
+#include "VLMAnalyzer.h"
+#include "VLMTranspositionTable.h"
+#include "VLMResultCache.h"
+
+//! @brief JSON Lines形式の解図要求を受け付け、常駐する解図threadで解図する
+//! @note 要求(1行): {"id":"q1","board":"hhhi","depth":7,"dual":false,"node_limit":0,"time_limit":0,"progress":0}
+//! @note 応答(1行): 解図を終えた順に{"id":"q1","event":"result",...}を出力する(不正な要求は"event":"error")
+//! @note 置換表は攻め側(手番)ごとに1つずつ確保し、要求間で初期化せずに共有する(置換表の値は攻め側から見た値のため、攻め側が異なる局面とは共有しない)
+class VLMSolverServer
+{
+  friend class VLMSolverServerTest;
+
+public:
+  //! @param table_space 置換表のサイズ[MB](攻め側ごとに確保する)
+  VLMSolverServer(const size_t table_space);
+
+  //! @brief 解図結果キャッシュを設定する(全解図threadで共有する)
+  void SetResultCache(const std::shared_ptr<realcore::VLMResultCache> &result_cache);
+
+  //! @brief 入力ストリームの要求を終端まで読み込み、すべての要求を解図した後に終了する
+  //! @param thread_num 解図threadの数
+  //! @param vlm_search 解図設定の既定値(depth, dual, node_limit, time_limitは要求ごとに上書きする)
+  //! @param in_stream 要求の入力ストリーム
+  //! @param out_stream 応答の出力ストリーム
+  void Run(const size_t thread_num, const realcore::VLMSearch &vlm_search, std::istream &in_stream, std::ostream &out_stream);
+
+private:
+  //! @brief 解図要求
+  typedef struct structSolveRequest
+  {
+    structSolveRequest()
+    : progress_interval(0), is_progress_output(false)
+    {
+    }
+
+    std::string id;                     //!< 要求ID(応答にそのまま付与する)
+    realcore::MoveList board_sequence;  //!< 開始局面
+    realcore::VLMSearch vlm_search;     //!< 解図設定
+    std::uint64_t progress_interval;    //!< 進捗を出力するノード数の間隔
+    bool is_progress_output;            //!< 進捗を出力するか
+  }SolveRequest;
+
+  //! @brief 要求(1行)を解析する
+  //! @param request_line 要求
+  //! @param default_search 解図設定の既定値
+  //! @param request 解析した要求
+  //! @param error_message 解析に失敗した場合のエラー内容
+  //! @retval true 解析に成功
+  static const bool ParseRequest(const std::string &request_line, const realcore::VLMSearch &default_search, SolveRequest * const request, std::string * const error_message);
+
+  //! @brief 要求キューから要求を取り出す
+  //! @retval true 要求を取り出した, false 入力が終端に達し要求キューが空
+  const bool PopRequest(SolveRequest * const request);
+
+  //! @brief 要求キューが空になるまで解図する(解図thread)
+  void SolveWorker();
+
+  //! @brief 要求を解図し、解図結果を出力する
+  void Solve(const SolveRequest &request);
+
+  //! @brief 1行を出力する
+  void OutputLine(const std::string &line);
+
+  std::array<std::shared_ptr<realcore::VLMTable>, 2> vlm_table_;    //!< 置換表([0]: 黒の攻め, [1]: 白の攻め)
+  std::array<std::shared_ptr<realcore::VCFTable>, 2> vcf_table_;    //!< VCF探索用の置換表([0]: 黒の攻め, [1]: 白の攻め)
+  std::shared_ptr<realcore::VLMResultCache> result_cache_;          //!< 解図結果キャッシュ(nullptr: 使用しない)
+
+  std::deque<SolveRequest> request_queue_;    //!< 未解図の要求
+  bool is_input_end_;                         //!< 入力が終端に達したか
+  boost::mutex mutex_request_queue_;          //!< 要求キューのmutex
+  boost::condition_variable request_cond_;    //!< 要求の追加, 入力の終端を通知する
+
+  std::ostream *out_stream_;          //!< 応答の出力ストリーム
+  boost::mutex mutex_out_stream_;     //!< 応答の出力ストリームのmutex
+};
+
+#endif    // VLM_SOLVER_SERVER_H
@@ -0,0 +1,61 @@
+#include <iostream>
+
+#include <boost/program_options.hpp>
+
+#include "VLMSolverServer.h"
+
+using namespace std;
+using namespace boost::program_options;
+using namespace realcore;
+
+int main(int argc, char* argv[])
+{
+  // オプション設定
+  options_description option;
+
+  option.add_options()
+    ("thread,t", value<size_t>()->default_value(1), "解図threadの数(default: 1)")
+    ("table-space", value<size_t>()->default_value(kDefaultVLMTableSpace), "置換表のサイズ[MB](攻め側ごとに確保する)")
+    ("depth,d", value<VLMSearchDepth>()->default_value(7), "探索深さの既定値(要求のdepthで上書きする)")
+    ("no-relevance-zone", "影響領域によるAND nodeの枝刈りを行わない")
+    ("result-cache", value<string>(), "解図結果キャッシュのファイル名(対称な局面を含め、解図済の局面は探索しない)")
+    ("help,h", "ヘルプを表示");
+  
+  variables_map arg_map;
+  store(parse_command_line(argc, argv, option), arg_map);
+
+  if(arg_map.count("help")){
+    cout << "Usage: " << argv[0] << " [options]" << endl;
+    cout << option;
+    cout << "Note: reads JSON Lines requests from stdin and writes one JSON line per result to stdout" << endl;
+    cout << "Request: {\"id\":\"q1\",\"board\":\"hhhi\",\"depth\":7,\"dual\":false,\"node_limit\":0,\"time_limit\":0,\"progress\":1000000}" << endl;
+    cout << endl;
+    return 0;
+  }
+
+  VLMSearch vlm_search;
+  vlm_search.remain_depth = arg_map["depth"].as<VLMSearchDepth>();
+  vlm_search.detect_dual_solution = false;    // 余詰探索は要求のdualで指定した場合のみ行う
+  vlm_search.relevance_zone_pruning = !arg_map.count("no-relevance-zone");
+
+  // 置換表を確保してから要求を受け付ける(要求ごとの確保を省く)
+  VLMSolverServer vlm_solver_server(arg_map["table-space"].as<size_t>());
+
+  if(arg_map.count("result-cache")){
+    const auto cache_path = arg_map["result-cache"].as<string>();
+    const auto result_cache = make_shared<VLMResultCache>(cache_path, kDefaultResultCacheEntryNum);
+
+    if(!result_cache->IsOpen()){
+      cerr << "Failed to open the result cache: " << cache_path << endl;
+      return 1;
+    }
+
+    vlm_solver_server.SetResultCache(result_cache);
+  }
+
+  cerr << "Ready" << endl;
+
+  vlm_solver_server.Run(arg_map["thread"].as<size_t>(), vlm_search, cin, cout);
+
+  return 0;
+}
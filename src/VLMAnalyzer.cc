@@ -1,3 +1,5 @@
+#include <iomanip>
+
 #include "VLMAnalyzer.h"
 
 using namespace std;
@@ -5,15 +7,28 @@ using namespace std;
 namespace realcore{
 
 VLMAnalyzer::VLMAnalyzer(const MoveList &board_move_sequence)
+: VLMAnalyzer(board_move_sequence, kDefaultVLMTableLockFree)
+{
+}
+
+VLMAnalyzer::VLMAnalyzer(const MoveList &board_move_sequence, const bool table_lock_control)
 : Board(board_move_sequence, board_move_sequence.IsBlackTurn() ? kUpdateVLMAnalyzerBlack : kUpdateVLMAnalyzerWhite), 
   search_manager_(kDefaultNoInterruptionException)
 {
-  vlm_table_ = make_shared<VLMTable>(kDefaultVLMTableSpace, kDefaultVLMTableLockFree);
+  vlm_table_ = make_shared<VLMTable>(kDefaultVLMTableSpace, table_lock_control);
+  vcf_table_ = make_shared<VCFTable>(kDefaultVCFTableSpace, table_lock_control);
 }
 
 VLMAnalyzer::VLMAnalyzer(const MoveList &board_move_sequence, const shared_ptr<VLMTable> &vlm_table)
 : Board(board_move_sequence, board_move_sequence.IsBlackTurn() ? kUpdateVLMAnalyzerBlack : kUpdateVLMAnalyzerWhite), 
   search_manager_(kCatchInterruptException), vlm_table_(vlm_table)
+{
+  vcf_table_ = make_shared<VCFTable>(kMinimumVCFTableSpace, kDefaultVLMTableLockFree);
+}
+
+VLMAnalyzer::VLMAnalyzer(const MoveList &board_move_sequence, const shared_ptr<VLMTable> &vlm_table, const shared_ptr<VCFTable> &vcf_table)
+: Board(board_move_sequence, board_move_sequence.IsBlackTurn() ? kUpdateVLMAnalyzerBlack : kUpdateVLMAnalyzerWhite), 
+  search_manager_(kCatchInterruptException), vlm_table_(vlm_table), vcf_table_(vcf_table)
 {
 }
 
@@ -21,20 +36,71 @@ void VLMAnalyzer::Solve(const VLMSearch &vlm_search, VLMResult * const vlm_resul
 {
   assert(vlm_result != nullptr);
 
+  // 反復深化の継続用の情報(root nodeの候補手の順序, 反証済の候補手, 最善の防手)はResumeSolveのみが引き継ぐ
+  *vlm_result = VLMResult();
+
+  or_proof_record_.clear();
+  and_proof_record_.clear();
+
+  constexpr VLMSearchDepth start_depth = 1;
+  SolveIterative(start_depth, vlm_search, vlm_result);
+}
+
+void VLMAnalyzer::ResumeSolve(const VLMSearch &vlm_search, VLMResult * const vlm_result)
+{
+  assert(vlm_result != nullptr);
+
+  if(vlm_result->solved || vlm_result->disproved){
+    return;
+  }
+
+  // 探索済の深さの次の深さから継続する(中断した深さは探索済の深さに含まれない)
+  const VLMSearchDepth start_depth = vlm_result->search_depth == 0 ? 1 : vlm_result->search_depth + 2;
+
+  if(start_depth > vlm_search.remain_depth){
+    return;
+  }
+
+  SolveIterative(start_depth, vlm_search, vlm_result);
+}
+
+void VLMAnalyzer::SolveIterative(const VLMSearchDepth start_depth, const VLMSearch &vlm_search, VLMResult * const vlm_result)
+{
+  assert(vlm_result != nullptr);
+  assert(start_depth % 2 == 1);
+
   const bool is_black_turn = board_move_sequence_.IsBlackTurn();
   VLMSearch vlm_search_iterative = vlm_search;
   VLMSearchValue search_value = kVLMStrongDisproved;
 
-  for(VLMSearchDepth depth=1; depth<=vlm_search.remain_depth; depth+=2){
+  SetSearchBudget(vlm_search.node_limit, vlm_search.time_limit);
+  shortest_solution_ = vlm_search.shortest_solution;
+
+  progress_result_ = vlm_result;
+  next_progress_node_ = search_manager_.GetNode() + progress_node_interval_;
+
+  bool is_terminate = false;    // 最後に探索した深さを中断したか
+
+  for(VLMSearchDepth depth=start_depth; depth<=vlm_search.remain_depth; depth+=2){
     vlm_search_iterative.remain_depth = depth;
+    progress_depth_ = depth;
 
     search_value = SolveOR(is_black_turn, vlm_search_iterative, vlm_result);
 
+    // IsSearchTerminate()は上限のチェック, 進捗の通知を伴うため、探索を終えた時点の状態のみを参照する
+    is_terminate = IsSearchInterrupted();
+
+    if(!IsVLMProved(search_value) && !is_terminate){
+      // 詰む場合は証明木の取得後に通知する
+      const auto best_move = vlm_result->root_move_order.empty() ? kNullMove : vlm_result->root_move_order[0];
+      NotifyProgress(true, depth, best_move);
+    }
+
     if(IsVLMProved(search_value) || IsVLMDisproved(search_value)){
       break;
     }
 
-    if(search_manager_.IsTerminate()){
+    if(is_terminate){
       break;
     }
   }
@@ -43,21 +109,174 @@ void VLMAnalyzer::Solve(const VLMSearch &vlm_search, VLMResult * const vlm_resul
   vlm_result->solved = IsVLMProved(search_value);
   vlm_result->disproved = IsVLMDisproved(search_value);
   vlm_result->search_depth = vlm_search_iterative.remain_depth;
+  vlm_result->budget_exhausted = is_budget_exhausted_ && !vlm_result->solved && !vlm_result->disproved;
 
-  if(search_manager_.IsTerminate() && vlm_result->search_depth >= 3){
-    vlm_result->search_depth -= 2;
+  // 浅い深さで詰まないことを確認済 かつ 各局面で最短の詰みのみを採用しているため最短手順となる
+  vlm_result->shortest_solution = vlm_result->solved && vlm_search.shortest_solution;
+
+  if(is_terminate && !vlm_result->solved && !vlm_result->disproved){
+    // 中断した深さは探索済の深さに含めない(深さ1を中断した場合は0)
+    vlm_result->search_depth = vlm_result->search_depth >= 3 ? vlm_result->search_depth - 2 : 0;
   }
 
+  // 証明木の取得, 余詰探索は上限の対象外とする
+  SetSearchBudget(0, 0);
+
+  progress_result_ = nullptr;
+
   if(vlm_result->solved){
-    GetSummarizedProofTree(&vlm_result->proof_tree);
+    // 記録した証明木を取得できなかった場合(探索途中で記録を開始した場合等)は置換表から取得する
+    const bool is_recorded = vlm_search.record_proof_tree && GetRecordedProofTree(&vlm_result->proof_tree);
+
+    if(!is_recorded){
+      GetSummarizedProofTree(&vlm_result->proof_tree);
+    }
+
+    NotifyProgress(true, vlm_result->search_depth, vlm_result->proof_tree.GetTopNodeMove());
+  }
+
+  if(vlm_result->disproved && vlm_search.disproof_certificate){
+    GetDisproofCertificate(&vlm_result->disproof_certificate);
   }
 
   if(vlm_result->solved && vlm_search.detect_dual_solution && vlm_result->search_depth >= 3){
+    const auto dual_solution_start = chrono::steady_clock::now();
+    dual_solution_thread_ = max<size_t>(1, vlm_search.dual_solution_thread);
+
     MoveTree full_proof_tree;
     GetProofTree(&full_proof_tree);
 
     vlm_result->detect_dual_solution = DetectDualSolution(&full_proof_tree, &vlm_result->best_response, &vlm_result->dual_solution_tree);
+
+    const auto dual_solution_end = chrono::steady_clock::now();
+    dual_solution_time_ += chrono::duration_cast<chrono::milliseconds>(dual_solution_end - dual_solution_start).count();
+  }
+}
+
+void VLMAnalyzer::SetProgressCallback(const VLMProgressCallback &progress_callback, const std::uint64_t node_interval)
+{
+  progress_callback_ = progress_callback;
+  progress_node_interval_ = node_interval;
+}
+
+void VLMAnalyzer::SetYieldCallback(const std::function<void()> &yield_callback, const std::uint64_t node_interval)
+{
+  yield_callback_ = yield_callback;
+  SetYieldInterval(yield_callback ? node_interval : 0);
+}
+
+void VLMAnalyzer::SetYieldInterval(const std::uint64_t node_interval)
+{
+  yield_node_interval_ = node_interval;
+  next_yield_node_ = search_manager_.GetNode() + node_interval;
+}
+
+void VLMAnalyzer::NotifyProgress(const bool is_iteration_end, const VLMSearchDepth search_depth, const MovePosition best_move)
+{
+  if(!progress_callback_){
+    return;
   }
+
+  VLMProgress progress;
+  progress.is_iteration_end = is_iteration_end;
+  progress.search_depth = search_depth;
+  progress.node = search_manager_.GetNode();
+  progress.search_time = search_manager_.GetSearchTime();
+  progress.nps = progress.search_time == 0 ? 0 : 1000.0 * progress.node / progress.search_time;
+  progress.table_fill_rate = vlm_table_->GetFillRate();
+  progress.best_move = best_move;
+
+  progress_callback_(progress);
+}
+
+const string GetVLMProgressJSON(const VLMProgress &progress, const string &problem_id)
+{
+  stringstream ss;
+
+  ss << "{";
+
+  if(!problem_id.empty()){
+    ss << "\"id\":\"" << EscapeJSONString(problem_id) << "\",";
+  }
+
+  ss << "\"event\":\"" << (progress.is_iteration_end ? "iteration" : "progress") << "\",";
+  ss << "\"depth\":" << progress.search_depth << ",";
+  ss << "\"nodes\":" << progress.node << ",";
+  ss << "\"time_ms\":" << progress.search_time << ",";
+  ss << "\"nps\":" << static_cast<uint64_t>(progress.nps) << ",";
+  ss << "\"tt_fill\":" << progress.table_fill_rate << ",";
+
+  if(progress.best_move == kNullMove){
+    ss << "\"best_move\":null";
+  }else{
+    ss << "\"best_move\":\"" << MoveString(progress.best_move) << "\"";
+  }
+
+  ss << "}";
+
+  return ss.str();
+}
+
+const string EscapeJSONString(const string &str)
+{
+  stringstream ss;
+
+  for(const auto c : str){
+    if(c == '"' || c == '\\'){
+      ss << '\\' << c;
+    }else if(static_cast<unsigned char>(c) < 0x20){
+      ss << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec;
+    }else{
+      ss << c;
+    }
+  }
+
+  return ss.str();
+}
+
+void VLMAnalyzer::SetSearchBudget(const std::uint64_t node_limit, const std::uint64_t time_limit)
+{
+  budget_node_limit_ = node_limit == 0 ? 0 : search_manager_.GetNode() + node_limit;
+  is_time_limited_ = time_limit != 0;
+  budget_deadline_ = chrono::steady_clock::now() + chrono::milliseconds(time_limit);
+  budget_check_count_ = 0;
+  is_budget_exhausted_ = false;
+}
+
+void VLMAnalyzer::ReorderRootCandidateMove(const VLMResult &vlm_result, MoveList * const candidate_move) const
+{
+  assert(candidate_move != nullptr);
+
+  if(vlm_result.root_move_order.empty() && vlm_result.refuted_root_move.none()){
+    return;
+  }
+
+  MoveBitSet candidate_move_bit;
+
+  for(const auto move : *candidate_move){
+    candidate_move_bit.set(move);
+  }
+
+  MoveList ordered_move;
+  MoveBitSet ordered_move_bit(vlm_result.refuted_root_move);
+
+  // 前回の反復で展開した順序
+  for(const auto move : vlm_result.root_move_order){
+    if(candidate_move_bit[move] && !ordered_move_bit[move]){
+      ordered_move += move;
+      ordered_move_bit.set(move);
+    }
+  }
+
+  // 前回の反復で展開していない手(探索の中断等)
+  for(const auto move : *candidate_move){
+    if(!ordered_move_bit[move]){
+      ordered_move += move;
+      ordered_move_bit.set(move);
+    }
+  }
+
+  *candidate_move = ordered_move;
 }
 
 VLMSearchValue VLMAnalyzer::SolveOR(const bool is_black_turn, const VLMSearch &vlm_search, VLMResult * const vlm_result)
@@ -73,6 +292,7 @@ void VLMAnalyzer::MakeMove(const MovePosition move)
 {
   search_sequence_ += move;
   Board::MakeMove(move);
+  UpdateForbiddenMoveCache(move);
 }
 
 void VLMAnalyzer::MakeMove(const VLMSearch &child_vlm_search, const MovePosition move)
@@ -96,6 +316,7 @@ void VLMAnalyzer::MakeMove(const VLMSearch &child_vlm_search, const MovePosition
   }
 
   search_sequence_ += move;
+  UpdateForbiddenMoveCache(move);
 }
 
 void VLMAnalyzer::UndoMove()
@@ -104,184 +325,146 @@ void VLMAnalyzer::UndoMove()
   Board::UndoMove();
 }
 
-template<>
-void VLMAnalyzer::MoveOrderingOR<kBlackTurn>(const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
+void VLMAnalyzer::GetForbiddenMoveBit(MoveBitSet * const forbidden_bit) const
 {
-  assert(candidate_move != nullptr);
-  assert(candidate_move->empty());
-
-  constexpr PlayerTurn P = kBlackTurn;
+  assert(forbidden_bit != nullptr);
 
-  MoveBitSet four_bit, three_bit;
-  EnumerateFourMoves<P>(&four_bit);
-  EnumerateSemiThreeMoves<P>(&three_bit);
+  const size_t ply = search_sequence_.size();
 
-  MoveBitSet mise_bit, multi_mise_bit;
-
-  // @see doc/02_performance/vlm_analyzer_performance.pptx, 「OR nodeの指し手」
-  if(vlm_search.remain_depth >= 3){
-    // 残り深さ３以上
-    // 四三を作る手を優先する
-    MoveBitSet four_three_bit(four_bit & three_bit);
-    SelectMove(four_three_bit, candidate_move_bit, candidate_move);
+  if(ply >= forbidden_bit_cache_.size()){
+    forbidden_bit_cache_.resize(ply + 1);
+    forbidden_bit_cached_.resize(ply + 1, false);
   }
-  
-  if(vlm_search.remain_depth >= 5){
-    // 残り深さ5以上
-    // (四 or 三) & ミセ手
-    EnumerateMiseMoves<P>(&mise_bit, &multi_mise_bit);
-
-    {
-      MoveBitSet threat_mise_bit((four_bit | three_bit) & mise_bit);
-      SelectMove(threat_mise_bit, candidate_move_bit, candidate_move);
-    }
 
-    // 両ミセ
-    SelectMove(multi_mise_bit, candidate_move_bit, candidate_move);
+  if(!forbidden_bit_cached_[ply]){
+    EnumerateForbiddenMoves(&forbidden_bit_cache_[ply]);
+    forbidden_bit_cached_[ply] = true;
   }
 
-  // 剣先
-  if(vlm_search.remain_depth >= 5){
-    MoveBitSet point_of_sword_bit;
-    EnumeratePointOfSwordMoves<P>(&point_of_sword_bit);
-    SelectMove(point_of_sword_bit, candidate_move_bit, candidate_move);
+  *forbidden_bit = forbidden_bit_cache_[ply];
+}
+
+void VLMAnalyzer::UpdateForbiddenMoveCache(const MovePosition move)
+{
+  const size_t ply = search_sequence_.size();
+
+  if(ply >= forbidden_bit_cache_.size()){
+    forbidden_bit_cache_.resize(ply + 1);
+    forbidden_bit_cached_.resize(ply + 1, false);
   }
 
-  // 二
-  if(vlm_search.remain_depth >= 5){
-    MoveBitSet two_bit;
-    EnumerateTwoMoves<P>(&two_bit);
-    SelectMove(two_bit, candidate_move_bit, candidate_move);
+  const bool is_parent_cached = forbidden_bit_cached_[ply - 1];
+
+  if(move == kNullMove && is_parent_cached){
+    forbidden_bit_cache_[ply] = forbidden_bit_cache_[ply - 1];
+    forbidden_bit_cached_[ply] = true;
+  }else{
+    forbidden_bit_cached_[ply] = false;
   }
+}
 
-  // 四
-  SelectMove(four_bit, candidate_move_bit, candidate_move);
+const bool VLMAnalyzer::GetProofTree(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
 
-  // 三
-  SelectMove(three_bit, candidate_move_bit, candidate_move);
+  proof_tree->MoveRootNode();
 
-  // 残りの手をすべて生成
-  GetMoveList(*candidate_move_bit, candidate_move);
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  bool is_generated = false;
 
-  return;
-}
+  if(is_black_turn){
+    is_generated = GetProofTreeOR<kBlackTurn>(proof_tree, kGenerateFullTree);
+  }else{
+    is_generated = GetProofTreeOR<kWhiteTurn>(proof_tree, kGenerateFullTree);
+  }
 
-template<>
-void VLMAnalyzer::MoveOrderingOR<kWhiteTurn>(const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
-{
-  assert(candidate_move != nullptr);
-  assert(candidate_move->empty());
+  if(!is_generated){
+    proof_tree->clear();
+  }
 
-  constexpr PlayerTurn P = kWhiteTurn;
+  return is_generated;
+}
 
-  MoveBitSet four_bit, three_bit;
-  EnumerateFourMoves<P>(&four_bit);
-  EnumerateSemiThreeMoves<P>(&three_bit);
+const bool VLMAnalyzer::GetSummarizedProofTree(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
 
-  MoveBitSet point_of_sword_bit;
-  EnumeratePointOfSwordMoves<P>(&point_of_sword_bit);
+  proof_tree->MoveRootNode();
+  ClearSummarizedProofTreeMemo();
 
-  MoveBitSet mise_bit, multi_mise_bit;
+  const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  bool is_generated = false;
 
-  // @see doc/02_performance/vlm_analyzer_performance.pptx, 「OR nodeの指し手」
-  if(vlm_search.remain_depth >= 3){
-    // 残り深さ３以上
-    // 四三, 三々, (三 or 四) & 剣先点(四々ミセ、極め手ミセの代替)を優先する
-    {
-      // 四三
-      MoveBitSet four_three_move_bit(four_bit & three_bit);
-      four_three_move_bit &= *candidate_move_bit;
+  if(is_black_turn){
+    is_generated = GetProofTreeOR<kBlackTurn>(proof_tree, kGenerateSummarizedTree);
+  }else{
+    is_generated = GetProofTreeOR<kWhiteTurn>(proof_tree, kGenerateSummarizedTree);
+  }
 
-      GetMoveList(four_three_move_bit, candidate_move);
-      *candidate_move_bit ^= four_three_move_bit;
-    }
-    {
-      // 三々
-      MoveBitSet double_three_bit;
-      EnumerateDoubleSemiThreeMoves<P>(&double_three_bit);
-      double_three_bit &= *candidate_move_bit;
-
-      GetMoveList(double_three_bit, candidate_move);
-      *candidate_move_bit ^= double_three_bit;
-    }
-    {
-      // (三 or 四) & 剣先点(四々ミセ、極め手ミセの代替)
-      MoveBitSet threat_sword_move_bit((four_bit | three_bit) & point_of_sword_bit);
-      threat_sword_move_bit &= *candidate_move_bit;
+  ClearSummarizedProofTreeMemo();
 
-      GetMoveList(threat_sword_move_bit, candidate_move);
-      *candidate_move_bit ^= threat_sword_move_bit;
-    }
+  if(!is_generated){
+    proof_tree->clear();
   }
-  
-  if(vlm_search.remain_depth >= 5){
-    // 残り深さ5以上
-    // (四 or 三) & ミセ手
-    EnumerateMiseMoves<P>(&mise_bit, &multi_mise_bit);
 
-    {
-      MoveBitSet threat_mise_bit((four_bit | three_bit) & mise_bit);
-      threat_mise_bit &= *candidate_move_bit;
+  return is_generated;
+}
 
-      GetMoveList(threat_mise_bit, candidate_move);
-      *candidate_move_bit ^= threat_mise_bit;
-    }
+const bool VLMAnalyzer::FindSearchValue(const VLMSearch &vlm_search, const HashValue hash_value, VLMSearchValue * const search_value) const
+{
+  return FindSearchValue(vlm_search, hash_value, bit_board_, search_value);
+}
 
-    // 両ミセ
-    {
-      multi_mise_bit &= *candidate_move_bit;
+const bool VLMAnalyzer::FindSearchValue(const VLMSearch &vlm_search, const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value) const
+{
+  assert(search_value != nullptr);
 
-      GetMoveList(multi_mise_bit, candidate_move);
-      *candidate_move_bit ^= multi_mise_bit;
-    }
-    
-    // ミセ手 & 剣先点(四々ミセ、極め手ミセの代替)
-    {
-      MoveBitSet threat_sword_move_bit(mise_bit & point_of_sword_bit);
-      threat_sword_move_bit &= *candidate_move_bit;
-
-      GetMoveList(threat_sword_move_bit, candidate_move);
-      *candidate_move_bit ^= threat_sword_move_bit;
-    }
-  }
+  std::int16_t disproved_depth = 0;
 
-  // 剣先
-  if(vlm_search.remain_depth >= 5){
-    point_of_sword_bit &= *candidate_move_bit;
+  if(!vlm_table_->find(hash_value, bit_board, search_value, &disproved_depth)){
+    return false;
+  }
 
-    GetMoveList(point_of_sword_bit, candidate_move);
-    *candidate_move_bit ^= point_of_sword_bit;
+  if(!IsVLMProved(*search_value)){
+    return true;
   }
 
-  // 二ノビ
-  if(vlm_search.remain_depth >= 5){
-    MoveBitSet two_bit;
-    EnumerateTwoMoves<P>(&two_bit);
-    two_bit &= *candidate_move_bit;
+  const auto remain_depth = vlm_search.remain_depth;
+  const VLMSearchDepth proved_depth = GetVLMDepth(*search_value);
 
-    GetMoveList(two_bit, candidate_move);
-    *candidate_move_bit ^= two_bit;
+  if(proved_depth > remain_depth && disproved_depth >= remain_depth){
+    // 残り深さ以下の詰みはない
+    *search_value = GetVLMWeakDisprovedSearchValue(disproved_depth);
+    return true;
   }
 
-  // 四
-  four_bit &= *candidate_move_bit;
+  if(vlm_search.shortest_solution){
+    // 終端以外は1手では詰まないため、2手短い詰みがないことは深さ3以下なら自明
+    const VLMSearchDepth lower_depth = std::max<VLMSearchDepth>(disproved_depth, 1);
 
-  GetMoveList(four_bit, candidate_move);
-  *candidate_move_bit ^= four_bit;
+    if(proved_depth > remain_depth || proved_depth > lower_depth + 2){
+      // 最短であることを確認していない詰み -> 詰まないことを確認済の深さから再探索する
+      *search_value = GetVLMWeakDisprovedSearchValue(lower_depth);
+    }
+  }
 
-  // 三
-  three_bit &= *candidate_move_bit;
+  return true;
+}
 
-  GetMoveList(three_bit, candidate_move);
-  *candidate_move_bit ^= three_bit;
+void VLMAnalyzer::UpsertShortestBound(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value)
+{
+  if(!vlm_search.shortest_solution || !IsVLMProved(search_value)){
+    return;
+  }
 
-  // 残りの手をすべて生成
-  GetMoveList(*candidate_move_bit, candidate_move);
+  const auto proved_depth = GetVLMDepth(search_value);
 
-  return;
+  if(proved_depth >= 5){
+    vlm_table_->Upsert(hash_value, bit_board_, GetVLMWeakDisprovedSearchValue(proved_depth - 2));
+  }
 }
 
-const bool VLMAnalyzer::GetProofTree(MoveTree * const proof_tree)
+const bool VLMAnalyzer::GetRecordedProofTree(MoveTree * const proof_tree)
 {
   assert(proof_tree != nullptr);
 
@@ -291,9 +474,9 @@ const bool VLMAnalyzer::GetProofTree(MoveTree * const proof_tree)
   bool is_generated = false;
 
   if(is_black_turn){
-    is_generated = GetProofTreeOR<kBlackTurn>(proof_tree, kGenerateFullTree);
+    is_generated = GetRecordedProofTreeOR<kBlackTurn>(proof_tree);
   }else{
-    is_generated = GetProofTreeOR<kWhiteTurn>(proof_tree, kGenerateFullTree);
+    is_generated = GetRecordedProofTreeOR<kWhiteTurn>(proof_tree);
   }
 
   if(!is_generated){
@@ -303,26 +486,83 @@ const bool VLMAnalyzer::GetProofTree(MoveTree * const proof_tree)
   return is_generated;
 }
 
-const bool VLMAnalyzer::GetSummarizedProofTree(MoveTree * const proof_tree)
+const bool VLMAnalyzer::GetDisproofCertificate(string * const certificate)
 {
-  assert(proof_tree != nullptr);
+  assert(certificate != nullptr);
 
-  proof_tree->MoveRootNode();
+  // ヘッダ
+  string generated_certificate(kDisproofCertificateMagic);
+  generated_certificate += static_cast<char>(kDisproofCertificateVersion);
+  generated_certificate += static_cast<char>(board_move_sequence_.size());
 
+  for(const auto move : board_move_sequence_){
+    generated_certificate += static_cast<char>(move);
+  }
+
+  // 本体
   const bool is_black_turn = board_move_sequence_.IsBlackTurn();
   bool is_generated = false;
 
+  disproof_and_memo_.clear();
+  disproof_certificate_node_ = 0;
+
   if(is_black_turn){
-    is_generated = GetProofTreeOR<kBlackTurn>(proof_tree, kGenerateSummarizedTree);
+    is_generated = GetDisproofCertificateOR<kBlackTurn>(&generated_certificate);
   }else{
-    is_generated = GetProofTreeOR<kWhiteTurn>(proof_tree, kGenerateSummarizedTree);
+    is_generated = GetDisproofCertificateOR<kWhiteTurn>(&generated_certificate);
   }
 
-  if(!is_generated){
-    proof_tree->clear();
+  disproof_and_memo_.clear();
+
+  // 上限を超えた後にメモから取得できた場合も、上限を超えた取得は失敗とする
+  if(!is_generated || disproof_certificate_node_ > kDisproofCertificateNodeLimit){
+    return false;
   }
 
-  return is_generated;
+  *certificate = generated_certificate;
+  return true;
+}
+
+void VLMAnalyzer::RecordProofOR(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value, const MovePosition move)
+{
+  if(!vlm_search.record_proof_tree){
+    return;
+  }
+
+  // 記録済の詰みより短い詰みのみ上書きする(探索値が大きいほど短い)
+  const auto find_it = or_proof_record_.find(hash_value);
+
+  if(find_it == or_proof_record_.end() && or_proof_record_.size() >= kMaxProofRecordNum){
+    return;
+  }
+
+  if(find_it == or_proof_record_.end() || find_it->second.first < search_value){
+    or_proof_record_[hash_value] = make_pair(search_value, move);
+  }
+}
+
+void VLMAnalyzer::RecordProofAND(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value, const MoveList &move_list)
+{
+  if(!vlm_search.record_proof_tree){
+    return;
+  }
+
+  const auto find_it = and_proof_record_.find(hash_value);
+
+  if(find_it == and_proof_record_.end() && and_proof_record_.size() >= kMaxProofRecordNum){
+    return;
+  }
+
+  if(find_it == and_proof_record_.end() || find_it->second.first < search_value){
+    and_proof_record_[hash_value] = make_pair(search_value, move_list);
+  }
+}
+
+void VLMAnalyzer::ClearSummarizedProofTreeMemo()
+{
+  summarized_or_memo_.clear();
+  summarized_and_memo_.clear();
+  threat_proof_tree_memo_.clear();
 }
 
 const bool VLMAnalyzer::DetectDualSolution(MoveTree * const proof_tree, MoveList * const best_response, MoveTree * const dual_solution_tree)
@@ -358,26 +598,105 @@ void VLMAnalyzer::GetPreTerminateHash(MoveTree * const proof_tree, std::set<Hash
   assert(pre_terminate_hash_set != nullptr);
   assert(pre_terminate_hash_set->empty());
 
-  std::vector<MoveNodeIndex> leaf_index_list;
-
-  proof_tree->GetLeafNodeList(&leaf_index_list);
+  // 深さ優先で走査し、OR node手順のHash値を差分で更新する
   const bool is_black_turn = board_move_sequence_.IsBlackTurn();
+  constexpr size_t root_depth = 0;
+  constexpr HashValue root_hash_value = 0;
+
+  proof_tree->MoveRootNode();
+  GetPreTerminateHash(proof_tree, is_black_turn, root_depth, root_hash_value, root_hash_value, pre_terminate_hash_set);
+}
+
+void VLMAnalyzer::GetPreTerminateHash(MoveTree * const proof_tree, const bool is_black_turn, const size_t depth, const HashValue parent_hash_value, const HashValue hash_value, std::set<HashValue> * const pre_terminate_hash_set) const
+{
+  MoveList child_move_list;
+  proof_tree->GetChildMoveList(&child_move_list);
+
+  if(child_move_list.empty()){
+    // 終端局面: 直前の局面(親node)のHash値を記録する
+    pre_terminate_hash_set->insert(parent_hash_value);
+    return;
+  }
+
+  // OR node(偶数の深さ)の指し手のみHash値に含める
+  const bool is_or_node = depth % 2 == 0;
 
-  for(const auto leaf_index : leaf_index_list){
-    proof_tree->MoveNode(leaf_index);
+  for(const auto move : child_move_list){
+    const HashValue child_hash_value = is_or_node ? CalcHashValue(is_black_turn, move, hash_value) : hash_value;
+
+    proof_tree->MoveChildNode(move);
+    GetPreTerminateHash(proof_tree, is_black_turn, depth + 1, hash_value, child_hash_value, pre_terminate_hash_set);
     proof_tree->MoveParent();
+  }
+}
 
-    MoveList move_list;
-    proof_tree->GetMoveList(&move_list);
+void VLMAnalyzer::GetProofTreeMoveBit(MoveTree * const proof_tree, MoveBitSet * const proof_tree_move_bit) const
+{
+  assert(proof_tree != nullptr);
+  assert(proof_tree_move_bit != nullptr);
+
+  MoveList child_move_list;
+  proof_tree->GetChildMoveList(&child_move_list);
+
+  for(const auto move : child_move_list){
+    proof_tree_move_bit->set(move);
 
-    HashValue hash_value = 0;
+    proof_tree->MoveChildNode(move);
+    GetProofTreeMoveBit(proof_tree, proof_tree_move_bit);
+    proof_tree->MoveParent();
+  }
+}
 
-    // OR nodeのHash値を求める
-    for(size_t i=0, size=move_list.size(); i<size; i+=2){
-      hash_value = CalcHashValue(is_black_turn, move_list[i], hash_value);
+const MoveBitSet& VLMAnalyzer::GetLineNeighborhood(const MovePosition move)
+{
+  // 全指し手の直線近傍を初回呼び出し時に生成する
+  static const array<MoveBitSet, kMoveNum> line_neighborhood_table = [](){
+    array<MoveBitSet, kMoveNum> table;
+    constexpr array<int, 4> dx_list{{1, 0, 1, 1}};
+    constexpr array<int, 4> dy_list{{0, 1, 1, -1}};
+
+    for(size_t move_index=0; move_index<kMoveNum; move_index++){
+      const auto center_move = static_cast<MovePosition>(move_index);
+      Cordinate x = 0, y = 0;
+      GetMoveCordinate(center_move, &x, &y);
+
+      if(!IsInBoard(x, y)){
+        continue;
+      }
+
+      for(size_t direction=0; direction<4; direction++){
+        for(int distance=-kRelevanceZoneDistance; distance<=kRelevanceZoneDistance; distance++){
+          const int neighbor_x = static_cast<int>(x) + distance * dx_list[direction];
+          const int neighbor_y = static_cast<int>(y) + distance * dy_list[direction];
+
+          if(neighbor_x < 0 || neighbor_y < 0){
+            continue;
+          }
+
+          const auto cordinate_x = static_cast<Cordinate>(neighbor_x);
+          const auto cordinate_y = static_cast<Cordinate>(neighbor_y);
+
+          if(IsInBoard(cordinate_x, cordinate_y)){
+            table[move_index].set(GetMove(cordinate_x, cordinate_y));
+          }
+        }
+      }
     }
 
-    pre_terminate_hash_set->insert(hash_value);
+    return table;
+  }();
+
+  return line_neighborhood_table[move];
+}
+
+void VLMAnalyzer::AddLineNeighborhood(const MoveBitSet &move_bit, MoveBitSet * const neighborhood_bit)
+{
+  assert(neighborhood_bit != nullptr);
+
+  for(size_t move_index=0; move_index<kMoveNum; move_index++){
+    if(move_bit[move_index]){
+      *neighborhood_bit |= GetLineNeighborhood(static_cast<MovePosition>(move_index));
+    }
   }
 }
 
@@ -0,0 +1,484 @@
+#include <atomic>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include "VLMProofVerifier.h"
+
+using namespace std;
+
+namespace realcore{
+
+VLMProofVerifier::VLMProofVerifier(const MoveList &board_move_sequence)
+: board_move_sequence_(board_move_sequence)
+{
+}
+
+const bool VLMProofVerifier::Verify(const MoveTree &proof_tree, const size_t thread_num) const
+{
+  assert(thread_num >= 1);
+
+  if(board_move_sequence_.IsBlackTurn()){
+    return VerifyRoot<kBlackTurn>(proof_tree, thread_num);
+  }else{
+    return VerifyRoot<kWhiteTurn>(proof_tree, thread_num);
+  }
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::VerifyRoot(const MoveTree &proof_tree, const size_t thread_num) const
+{
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  // 置換表は使用しないため最小サイズで確保する
+  constexpr size_t table_space = 0;
+  VLMAnalyzer root_analyzer(board_move_sequence_, make_shared<VLMTable>(table_space, kLockFree), make_shared<VCFTable>(table_space, kLockFree));
+
+  MovePosition terminating_move;
+
+  if(root_analyzer.TerminateCheck(&terminating_move)){
+    return true;
+  }
+
+  // 独立した部分木(root nodeの詰む手 -> 防手)を列挙する
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  root_analyzer.GetCandidateMoveOR<P>(vlm_search, &candidate_move);
+
+  MoveBitSet candidate_move_bit;
+
+  for(const auto move : candidate_move){
+    candidate_move_bit.set(move);
+  }
+
+  MoveTree root_tree = proof_tree;
+  root_tree.MoveRootNode();
+
+  MoveList attack_move_list;
+  root_tree.GetChildMoveList(&attack_move_list);
+
+  vector<VerifyTask> task_list;
+  vector<bool> attack_valid(attack_move_list.size(), false);
+
+  for(size_t attack_index=0; attack_index<attack_move_list.size(); attack_index++){
+    const auto attack_move = attack_move_list[attack_index];
+
+    if(attack_move == kNullMove || !candidate_move_bit[attack_move]){
+      continue;
+    }
+
+    MoveList guard_move, tree_move;
+
+    root_tree.MoveChildNode(attack_move);
+    root_analyzer.MakeMove(attack_move);
+
+    attack_valid[attack_index] = GetGuardTreeMove<Q>(&root_analyzer, &root_tree, &guard_move, &tree_move);
+
+    root_analyzer.UndoMove();
+    root_tree.MoveParent();
+
+    if(!attack_valid[attack_index]){
+      continue;
+    }
+
+    for(size_t i=0; i<guard_move.size(); i++){
+      VerifyTask verify_task;
+      verify_task.attack_index = attack_index;
+      verify_task.attack_move = attack_move;
+      verify_task.guard_move = guard_move[i];
+      verify_task.tree_move = tree_move[i];
+
+      task_list.emplace_back(verify_task);
+    }
+  }
+
+  // 部分木を並行して検証する
+  const size_t task_count = task_list.size();
+  vector<char> task_result(task_count, 0);
+  atomic<size_t> next_index(0);
+
+  boost::thread_group thread_group;
+  const size_t verify_thread_num = std::max<size_t>(1, std::min(thread_num, task_count));
+
+  for(size_t i=0; i<verify_thread_num; i++){
+    thread_group.create_thread([this, table_space, &proof_tree, &task_list, &task_result, &next_index, task_count](){
+      VLMAnalyzer thread_analyzer(board_move_sequence_, make_shared<VLMTable>(table_space, kLockFree), make_shared<VCFTable>(table_space, kLockFree));
+      MoveTree thread_tree = proof_tree;
+
+      for(size_t index=next_index++; index<task_count; index=next_index++){
+        const auto &verify_task = task_list[index];
+
+        thread_tree.MoveRootNode();
+        thread_tree.MoveChildNode(verify_task.attack_move);
+        thread_tree.MoveChildNode(verify_task.tree_move);
+
+        thread_analyzer.MakeMove(verify_task.attack_move);
+        thread_analyzer.MakeMove(verify_task.guard_move);
+
+        task_result[index] = VerifyOR<P>(&thread_analyzer, &thread_tree);
+
+        thread_analyzer.UndoMove();
+        thread_analyzer.UndoMove();
+      }
+    });
+  }
+
+  thread_group.join_all();
+
+  // いずれかの詰む手ですべての防手の部分木が詰めば検証成功
+  for(size_t i=0; i<task_count; i++){
+    if(!task_result[i]){
+      attack_valid[task_list[i].attack_index] = false;
+    }
+  }
+
+  for(const bool is_valid : attack_valid){
+    if(is_valid){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::VerifyOR(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree)
+{
+  assert(vlm_analyzer != nullptr);
+  assert(proof_tree != nullptr);
+
+  MovePosition terminating_move;
+
+  if(vlm_analyzer->TerminateCheck(&terminating_move)){
+    // 終端
+    return true;
+  }
+
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  vlm_analyzer->GetCandidateMoveOR<P>(vlm_search, &candidate_move);
+
+  MoveBitSet candidate_move_bit;
+
+  for(const auto move : candidate_move){
+    candidate_move_bit.set(move);
+  }
+
+  MoveList attack_move_list;
+  proof_tree->GetChildMoveList(&attack_move_list);
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  for(const auto move : attack_move_list){
+    if(move == kNullMove || !candidate_move_bit[move]){
+      continue;
+    }
+
+    proof_tree->MoveChildNode(move);
+    vlm_analyzer->MakeMove(move);
+
+    const bool is_verified = VerifyAND<Q>(vlm_analyzer, proof_tree);
+
+    vlm_analyzer->UndoMove();
+    proof_tree->MoveParent();
+
+    if(is_verified){
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::VerifyAND(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree)
+{
+  assert(vlm_analyzer != nullptr);
+  assert(proof_tree != nullptr);
+
+  MoveList guard_move, tree_move;
+
+  if(!GetGuardTreeMove<P>(vlm_analyzer, proof_tree, &guard_move, &tree_move)){
+    return false;
+  }
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  for(size_t i=0; i<guard_move.size(); i++){
+    proof_tree->MoveChildNode(tree_move[i]);
+    vlm_analyzer->MakeMove(guard_move[i]);
+
+    const bool is_verified = VerifyOR<Q>(vlm_analyzer, proof_tree);
+
+    vlm_analyzer->UndoMove();
+    proof_tree->MoveParent();
+
+    if(!is_verified){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::GetGuardTreeMove(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree, MoveList * const guard_move, MoveList * const tree_move)
+{
+  assert(vlm_analyzer != nullptr);
+  assert(proof_tree != nullptr);
+  assert(guard_move != nullptr && guard_move->empty());
+  assert(tree_move != nullptr && tree_move->empty());
+
+  MovePosition terminating_move;
+
+  if(vlm_analyzer->TerminateCheck(&terminating_move)){
+    // 防御側の勝ち
+    return false;
+  }
+
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  vlm_analyzer->GetCandidateMoveAND<P>(vlm_search, &candidate_move);
+
+  MoveList proof_tree_move;
+  proof_tree->GetChildMoveList(&proof_tree_move);
+
+  MoveBitSet proof_tree_move_bit;
+  bool has_pass = false;
+
+  for(const auto move : proof_tree_move){
+    if(move == kNullMove){
+      has_pass = true;
+    }else{
+      proof_tree_move_bit.set(move);
+    }
+  }
+
+  for(const auto move : candidate_move){
+    if(move != kNullMove && proof_tree_move_bit[move]){
+      *guard_move += move;
+      *tree_move += move;
+    }else if(has_pass){
+      // 証明木にない防手はPassと同一手順で詰むことを確認する
+      *guard_move += move;
+      *tree_move += kNullMove;
+    }else{
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const bool VLMProofVerifier::VerifyDisproofCertificate(const std::string &certificate) const
+{
+  // ヘッダ
+  const string magic(kDisproofCertificateMagic);
+  const size_t header_size = magic.size() + 2;
+
+  if(certificate.size() < header_size || certificate.compare(0, magic.size(), magic) != 0){
+    return false;
+  }
+
+  size_t position = magic.size();
+
+  if(static_cast<uint8_t>(certificate[position++]) != kDisproofCertificateVersion){
+    return false;
+  }
+
+  const size_t move_count = static_cast<uint8_t>(certificate[position++]);
+
+  if(move_count != board_move_sequence_.size() || certificate.size() < header_size + move_count){
+    return false;
+  }
+
+  for(size_t i=0; i<move_count; i++){
+    if(static_cast<MovePosition>(static_cast<uint8_t>(certificate[position++])) != board_move_sequence_[i]){
+      // 別の局面の証明書
+      return false;
+    }
+  }
+
+  // 本体
+  constexpr size_t table_space = 0;
+  VLMAnalyzer vlm_analyzer(board_move_sequence_, make_shared<VLMTable>(table_space, kLockFree), make_shared<VCFTable>(table_space, kLockFree));
+  bool is_verified = false;
+
+  if(board_move_sequence_.IsBlackTurn()){
+    is_verified = VerifyDisproofOR<kBlackTurn>(&vlm_analyzer, certificate, &position);
+  }else{
+    is_verified = VerifyDisproofOR<kWhiteTurn>(&vlm_analyzer, certificate, &position);
+  }
+
+  // 証明書をすべて読み込んでいること
+  return is_verified && position == certificate.size();
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::VerifyDisproofOR(VLMAnalyzer * const vlm_analyzer, const std::string &certificate, size_t * const position)
+{
+  assert(vlm_analyzer != nullptr);
+  assert(position != nullptr);
+
+  MovePosition terminating_move;
+
+  if(vlm_analyzer->TerminateCheck(&terminating_move)){
+    // 攻め側の勝ち
+    return false;
+  }
+
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  vlm_analyzer->GetCandidateMoveOR<P>(vlm_search, &candidate_move);
+
+  MoveBitSet candidate_move_bit;
+
+  for(const auto move : candidate_move){
+    candidate_move_bit.set(move);
+  }
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  if(*position >= certificate.size()){
+    return false;
+  }
+
+  // 例外の候補手: 候補手ごとのAND node
+  const size_t exception_count = static_cast<uint8_t>(certificate[(*position)++]);
+  MoveBitSet verified_move_bit;
+
+  for(size_t i=0; i<exception_count; i++){
+    if(*position >= certificate.size()){
+      return false;
+    }
+
+    const auto move = static_cast<MovePosition>(static_cast<uint8_t>(certificate[(*position)++]));
+
+    if(!candidate_move_bit[move] || verified_move_bit[move]){
+      // 候補手ではない or 重複
+      return false;
+    }
+
+    vlm_analyzer->MakeMove(move);
+    const bool is_verified = VerifyDisproofAND<Q>(vlm_analyzer, certificate, position);
+    vlm_analyzer->UndoMove();
+
+    if(!is_verified){
+      return false;
+    }
+
+    verified_move_bit.set(move);
+  }
+
+  if(*position >= certificate.size()){
+    return false;
+  }
+
+  // 既定のAND node: 例外以外のすべての候補手で同じ証明書を検証する
+  const auto default_tag = static_cast<uint8_t>(certificate[(*position)++]);
+  const size_t default_position = *position;
+  size_t end_position = default_position;
+  bool is_default_used = false;
+
+  for(const auto move : candidate_move){
+    if(verified_move_bit[move]){
+      continue;
+    }
+
+    if(default_tag != kDisproofDefaultTag){
+      return false;
+    }
+
+    size_t move_position = default_position;
+
+    vlm_analyzer->MakeMove(move);
+    const bool is_verified = VerifyDisproofAND<Q>(vlm_analyzer, certificate, &move_position);
+    vlm_analyzer->UndoMove();
+
+    if(!is_verified || (is_default_used && move_position != end_position)){
+      return false;
+    }
+
+    end_position = move_position;
+    is_default_used = true;
+  }
+
+  if(default_tag == kDisproofDefaultTag && !is_default_used){
+    // 使われない既定のAND nodeは読み飛ばせないため不正とする
+    return false;
+  }
+
+  if(default_tag != kDisproofDefaultTag && default_tag != kDisproofNoDefaultTag){
+    return false;
+  }
+
+  *position = end_position;
+  return true;
+}
+
+template<PlayerTurn P>
+const bool VLMProofVerifier::VerifyDisproofAND(VLMAnalyzer * const vlm_analyzer, const std::string &certificate, size_t * const position)
+{
+  assert(vlm_analyzer != nullptr);
+  assert(position != nullptr);
+
+  if(*position >= certificate.size()){
+    return false;
+  }
+
+  const auto tag = static_cast<uint8_t>(certificate[(*position)++]);
+
+  if(tag == kDisproofTerminalTag){
+    MovePosition terminating_move;
+    return vlm_analyzer->TerminateCheck(&terminating_move);
+  }
+
+  if(tag != kDisproofGuardTag || *position >= certificate.size()){
+    return false;
+  }
+
+  const auto guard_move = static_cast<MovePosition>(static_cast<uint8_t>(certificate[(*position)++]));
+
+  // 防手が合法であること(相手に終端の脅威がある場合は終端手防手であること)
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  vlm_analyzer->GetCandidateMoveAND<P>(vlm_search, &candidate_move);
+
+  bool is_candidate = false;
+
+  for(const auto move : candidate_move){
+    if(move == guard_move){
+      is_candidate = true;
+      break;
+    }
+  }
+
+  if(!is_candidate){
+    return false;
+  }
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  vlm_analyzer->MakeMove(guard_move);
+  const bool is_verified = VerifyDisproofOR<Q>(vlm_analyzer, certificate, position);
+  vlm_analyzer->UndoMove();
+
+  return is_verified;
+}
+
+}   // namespace realcore
@@ -0,0 +1,416 @@
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+#include <boost/interprocess/file_mapping.hpp>
+
+#include "VLMResultCache.h"
+
+using namespace std;
+namespace bip = boost::interprocess;
+
+namespace realcore{
+
+VLMResultCache::VLMResultCache(const std::string &cache_path, const size_t entry_num)
+: entry_(nullptr), entry_num_(entry_num), hit_count_(0)
+{
+  assert(entry_num >= 1);
+  const size_t file_size = sizeof(ResultCacheHeader) + entry_num * sizeof(ResultCacheEntry);
+
+  // 存在しない or サイズが異なる場合は作成し直す
+  size_t current_size = 0;
+
+  {
+    ifstream cache_file(cache_path, ios::in | ios::binary | ios::ate);
+    current_size = cache_file ? static_cast<size_t>(cache_file.tellg()) : 0;
+  }
+
+  if(current_size != file_size){
+    ofstream cache_file(cache_path, ios::out | ios::binary | ios::trunc);
+
+    if(!cache_file){
+      return;
+    }
+
+    cache_file.seekp(file_size - 1);
+    cache_file.put(0);
+  }
+
+  try{
+    bip::file_mapping file_mapping(cache_path.c_str(), bip::read_write);
+    bip::mapped_region mapped_region(file_mapping, bip::read_write, 0, file_size);
+    mapped_region_.swap(mapped_region);
+  }catch(const bip::interprocess_exception &){
+    return;
+  }
+
+  char * const address = static_cast<char*>(mapped_region_.get_address());
+  ResultCacheHeader * const header = reinterpret_cast<ResultCacheHeader*>(address);
+  entry_ = reinterpret_cast<ResultCacheEntry*>(address + sizeof(ResultCacheHeader));
+
+  const bool is_valid_header = memcmp(header->magic, kResultCacheMagic, sizeof(header->magic)) == 0 &&
+    header->version == kResultCacheVersion && header->entry_num == entry_num && header->entry_size == sizeof(ResultCacheEntry);
+
+  if(!is_valid_header){
+    memset(address, 0, file_size);
+
+    memcpy(header->magic, kResultCacheMagic, sizeof(header->magic));
+    header->version = kResultCacheVersion;
+    header->entry_num = entry_num;
+    header->entry_size = sizeof(ResultCacheEntry);
+  }
+}
+
+VLMResultCache::~VLMResultCache()
+{
+  if(IsOpen()){
+    mapped_region_.flush();
+  }
+}
+
+const bool VLMResultCache::IsOpen() const
+{
+  return entry_ != nullptr;
+}
+
+const bool VLMResultCache::Find(const MoveList &board_sequence, const VLMSearch &vlm_search, VLMResult * const vlm_result) const
+{
+  assert(vlm_result != nullptr);
+
+  if(!IsOpen()){
+    return false;
+  }
+
+  BoardSymmetry symmetry = kIdenticalSymmetry;
+  vector<uint8_t> stone;
+  HashValue hash_value = 0;
+
+  if(!GetCanonicalBoard(board_sequence, &symmetry, &stone, &hash_value)){
+    return false;
+  }
+
+  ResultCacheEntry entry;
+
+  {
+    lock_guard<mutex> lock(mutex_);
+    const ResultCacheEntry &table_entry = GetEntry(hash_value);
+
+    const bool is_same_board = table_entry.is_used && table_entry.hash_value == hash_value &&
+      table_entry.stone_num == stone.size() && equal(stone.begin(), stone.end(), table_entry.stone.begin());
+
+    if(!is_same_board){
+      return false;
+    }
+
+    entry = table_entry;
+  }
+
+  const bool is_solved = entry.result_flag & kResultCacheFlagSolved;
+  const bool is_disproved = entry.result_flag & kResultCacheFlagDisproved;
+
+  // 反復深化で探索する深さ(1, 3, 5, ...)のうち要求の深さ以下の最大値
+  const VLMSearchDepth limit_depth = vlm_search.remain_depth % 2 == 1 ? vlm_search.remain_depth : vlm_search.remain_depth - 1;
+
+  if(limit_depth < 1){
+    return false;
+  }
+
+  // 詰みは示した深さ以上の要求に結果を返す(示した深さ未満では詰まない)
+  // 強意の不詰は深さによらず結果を返す
+  const bool is_final_result = is_disproved || (is_solved && limit_depth >= entry.search_depth);
+
+  if(!is_final_result){
+    const VLMSearchDepth unsolved_depth = is_solved ? entry.search_depth - 2 : entry.search_depth;
+
+    if(limit_depth > unsolved_depth){
+      return false;
+    }
+
+    *vlm_result = VLMResult();
+    vlm_result->search_depth = limit_depth;
+    vlm_result->result_cached = true;
+
+    hit_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // 保存時の解図設定で得られない情報を要求された場合は探索する
+  if(is_solved){
+    if(vlm_search.detect_dual_solution && !(entry.result_flag & kResultCacheFlagDualSearched)){
+      return false;
+    }
+
+    if(vlm_search.shortest_solution && !(entry.result_flag & kResultCacheFlagShortest)){
+      return false;
+    }
+  }
+
+  if(is_disproved && vlm_search.disproof_certificate){
+    return false;
+  }
+
+  *vlm_result = VLMResult();
+  vlm_result->solved = is_solved;
+  vlm_result->disproved = is_disproved;
+  vlm_result->search_depth = is_disproved ? std::min(entry.search_depth, limit_depth) : entry.search_depth;
+  vlm_result->result_cached = true;
+
+  if(is_solved){
+    const BoardSymmetry inverse_symmetry = GetInverseSymmetry(symmetry);
+    const char *text = entry.text.data();
+
+    MoveTree proof_tree(string(text, entry.proof_tree_size));
+    GetSymmetricMoveTree(inverse_symmetry, &proof_tree, &vlm_result->proof_tree);
+    text += entry.proof_tree_size;
+
+    if(vlm_search.detect_dual_solution){
+      vlm_result->detect_dual_solution = entry.result_flag & kResultCacheFlagDualSolution;
+
+      MoveTree dual_solution_tree(string(text, entry.dual_solution_size));
+      GetSymmetricMoveTree(inverse_symmetry, &dual_solution_tree, &vlm_result->dual_solution_tree);
+      text += entry.dual_solution_size;
+
+      const MoveList best_response(string(text, entry.best_response_size));
+      GetSymmetricMoveList(inverse_symmetry, best_response, &vlm_result->best_response);
+    }
+
+    vlm_result->shortest_solution = vlm_search.shortest_solution;
+  }
+
+  hit_count_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void VLMResultCache::Upsert(const MoveList &board_sequence, const VLMSearch &vlm_search, const VLMResult &vlm_result)
+{
+  if(!IsOpen() || vlm_result.budget_exhausted){
+    return;
+  }
+
+  BoardSymmetry symmetry = kIdenticalSymmetry;
+  vector<uint8_t> stone;
+  HashValue hash_value = 0;
+
+  if(!GetCanonicalBoard(board_sequence, &symmetry, &stone, &hash_value)){
+    return;
+  }
+
+  ResultCacheEntry entry;
+  memset(&entry, 0, sizeof(entry));
+
+  entry.hash_value = hash_value;
+  entry.is_used = 1;
+  entry.search_depth = vlm_result.search_depth;
+  entry.stone_num = static_cast<uint8_t>(stone.size());
+  copy(stone.begin(), stone.end(), entry.stone.begin());
+
+  if(vlm_result.solved){
+    entry.result_flag |= kResultCacheFlagSolved;
+
+    // 証明木等は正規化した向きで保存する
+    MoveTree proof_tree = vlm_result.proof_tree;
+    proof_tree.MoveRootNode();
+    MoveTree canonical_proof_tree;
+    GetSymmetricMoveTree(symmetry, &proof_tree, &canonical_proof_tree);
+
+    string proof_tree_str = canonical_proof_tree.str();
+    string dual_solution_str, best_response_str;
+
+    if(vlm_search.detect_dual_solution){
+      entry.result_flag |= kResultCacheFlagDualSearched;
+      entry.result_flag |= vlm_result.detect_dual_solution ? kResultCacheFlagDualSolution : 0;
+
+      MoveTree dual_solution_tree = vlm_result.dual_solution_tree;
+      dual_solution_tree.MoveRootNode();
+      MoveTree canonical_dual_solution_tree;
+      GetSymmetricMoveTree(symmetry, &dual_solution_tree, &canonical_dual_solution_tree);
+      dual_solution_str = canonical_dual_solution_tree.str();
+
+      MoveList canonical_best_response;
+      GetSymmetricMoveList(symmetry, vlm_result.best_response, &canonical_best_response);
+      best_response_str = canonical_best_response.str();
+    }
+
+    entry.result_flag |= vlm_result.shortest_solution ? kResultCacheFlagShortest : 0;
+
+    if(proof_tree_str.size() + dual_solution_str.size() + best_response_str.size() > kResultCacheTextSize){
+      return;
+    }
+
+    entry.proof_tree_size = static_cast<uint16_t>(proof_tree_str.size());
+    entry.dual_solution_size = static_cast<uint16_t>(dual_solution_str.size());
+    entry.best_response_size = static_cast<uint16_t>(best_response_str.size());
+
+    const string text = proof_tree_str + dual_solution_str + best_response_str;
+    copy(text.begin(), text.end(), entry.text.begin());
+  }else if(vlm_result.disproved){
+    entry.result_flag |= kResultCacheFlagDisproved;
+  }
+
+  lock_guard<mutex> lock(mutex_);
+  ResultCacheEntry &table_entry = GetEntry(hash_value);
+
+  const bool is_same_board = table_entry.is_used && table_entry.hash_value == hash_value &&
+    table_entry.stone_num == stone.size() && equal(stone.begin(), stone.end(), table_entry.stone.begin());
+
+  if(is_same_board){
+    // 同一局面は詰み, 強意の不詰の結果 or 深く確認した結果を残す
+    const bool is_table_final = table_entry.result_flag & (kResultCacheFlagSolved | kResultCacheFlagDisproved);
+    const bool is_entry_final = entry.result_flag & (kResultCacheFlagSolved | kResultCacheFlagDisproved);
+
+    if(is_table_final && !is_entry_final){
+      return;
+    }
+
+    if(!is_table_final && !is_entry_final && table_entry.search_depth >= entry.search_depth){
+      return;
+    }
+
+    // 詰みは余詰判定, 最短手順の証明を含む結果を残す
+    const bool is_table_solved = table_entry.result_flag & kResultCacheFlagSolved;
+    const bool is_entry_solved = entry.result_flag & kResultCacheFlagSolved;
+
+    if(is_table_solved && is_entry_solved){
+      constexpr uint8_t detail_flag = kResultCacheFlagDualSearched | kResultCacheFlagShortest;
+      const uint8_t table_detail = table_entry.result_flag & detail_flag;
+      const uint8_t entry_detail = entry.result_flag & detail_flag;
+
+      if((table_detail & entry_detail) == entry_detail){
+        return;
+      }
+
+      // 証明木が同一の場合は保存済の結果のフラグと余詰の変化, 最善応手を引き継ぐ
+      const bool is_same_proof_tree = table_entry.proof_tree_size == entry.proof_tree_size &&
+        equal(entry.text.begin(), entry.text.begin() + entry.proof_tree_size, table_entry.text.begin());
+
+      if(is_same_proof_tree){
+        entry.result_flag |= table_entry.result_flag & kResultCacheFlagShortest;
+
+        if((table_detail & kResultCacheFlagDualSearched) && !(entry_detail & kResultCacheFlagDualSearched)){
+          // 証明木が同一のため、保存済の文字列は証明木, 余詰の変化, 最善応手の順にそのまま用いる
+          entry.result_flag |= table_entry.result_flag & (kResultCacheFlagDualSearched | kResultCacheFlagDualSolution);
+          entry.dual_solution_size = table_entry.dual_solution_size;
+          entry.best_response_size = table_entry.best_response_size;
+          entry.text = table_entry.text;
+        }
+      }
+    }
+  }
+
+  table_entry = entry;
+}
+
+const std::uint64_t VLMResultCache::GetHitCount() const
+{
+  return hit_count_.load(std::memory_order_relaxed);
+}
+
+const bool VLMResultCache::GetCanonicalBoard(const MoveList &board_sequence, BoardSymmetry * const symmetry, std::vector<std::uint8_t> * const stone, HashValue * const hash_value)
+{
+  assert(symmetry != nullptr);
+  assert(stone != nullptr);
+  assert(hash_value != nullptr);
+
+  for(const auto move : board_sequence){
+    if(!IsInBoardMove(move)){
+      return false;
+    }
+  }
+
+  // 8通りの対称変換のうち石(黒石の昇順, 白石の昇順)が辞書順で最小となるものを選ぶ
+  bool is_first = true;
+
+  for(const auto board_symmetry : GetBoardSymmetry()){
+    vector<uint8_t> black_stone, white_stone;
+
+    for(size_t i=0, size=board_sequence.size(); i<size; i++){
+      const auto symmetric_move = GetSymmetricMove(board_sequence[i], board_symmetry);
+      (i % 2 == 0 ? black_stone : white_stone).emplace_back(symmetric_move);
+    }
+
+    sort(black_stone.begin(), black_stone.end());
+    sort(white_stone.begin(), white_stone.end());
+    black_stone.insert(black_stone.end(), white_stone.begin(), white_stone.end());
+
+    if(is_first || black_stone < *stone){
+      *symmetry = board_symmetry;
+      *stone = black_stone;
+      is_first = false;
+    }
+  }
+
+  // 黒石, 白石を交互に並べた手順のHash値とする
+  const size_t black_num = (board_sequence.size() + 1) / 2;
+  MoveList canonical_sequence;
+
+  for(size_t i=0, size=board_sequence.size(); i<size; i++){
+    const size_t index = i % 2 == 0 ? i / 2 : black_num + i / 2;
+    canonical_sequence += static_cast<MovePosition>((*stone)[index]);
+  }
+
+  *hash_value = CalcHashValue(canonical_sequence);
+  return true;
+}
+
+const BoardSymmetry VLMResultCache::GetInverseSymmetry(const BoardSymmetry symmetry)
+{
+  for(const auto inverse_symmetry : GetBoardSymmetry()){
+    bool is_inverse = true;
+
+    for(size_t i=0; i<kMoveNum && is_inverse; i++){
+      const auto move = static_cast<MovePosition>(i);
+
+      if(!IsInBoardMove(move)){
+        continue;
+      }
+
+      is_inverse = GetSymmetricMove(GetSymmetricMove(move, symmetry), inverse_symmetry) == move;
+    }
+
+    if(is_inverse){
+      return inverse_symmetry;
+    }
+  }
+
+  assert(false);
+  return kIdenticalSymmetry;
+}
+
+void VLMResultCache::GetSymmetricMoveTree(const BoardSymmetry symmetry, MoveTree * const move_tree, MoveTree * const symmetric_tree)
+{
+  assert(move_tree != nullptr);
+  assert(symmetric_tree != nullptr);
+
+  MoveList child_move_list;
+  move_tree->GetChildMoveList(&child_move_list);
+
+  for(const auto move : child_move_list){
+    const auto symmetric_move = IsInBoardMove(move) ? GetSymmetricMove(move, symmetry) : move;
+
+    symmetric_tree->AddChild(symmetric_move);
+    symmetric_tree->MoveChildNode(symmetric_move);
+    move_tree->MoveChildNode(move);
+
+    GetSymmetricMoveTree(symmetry, move_tree, symmetric_tree);
+
+    move_tree->MoveParent();
+    symmetric_tree->MoveParent();
+  }
+}
+
+void VLMResultCache::GetSymmetricMoveList(const BoardSymmetry symmetry, const MoveList &move_list, MoveList * const symmetric_list)
+{
+  assert(symmetric_list != nullptr);
+  symmetric_list->clear();
+
+  for(const auto move : move_list){
+    *symmetric_list += IsInBoardMove(move) ? GetSymmetricMove(move, symmetry) : move;
+  }
+}
+
+ResultCacheEntry& VLMResultCache::GetEntry(const HashValue hash_value) const
+{
+  return entry_[hash_value % entry_num_];
+}
+
+}   // namespace realcore
@@ -0,0 +1,66 @@
+#include "VLMSlicedSolver.h"
+
+using namespace std;
+
+namespace realcore{
+
+VLMSlicedSolver::VLMSlicedSolver(const MoveList &board_move_sequence, const shared_ptr<VLMTable> &vlm_table, const VLMSearch &vlm_search)
+: vlm_analyzer_(board_move_sequence, vlm_table), vlm_search_(vlm_search), yield_(nullptr), is_finished_(false)
+{
+}
+
+const bool VLMSlicedSolver::Run(const uint64_t node_quantum)
+{
+  assert(node_quantum > 0);
+
+  if(is_finished_){
+    return true;
+  }
+
+  if(!solve_coroutine_){
+    // quantumを使い切るとSolveを中断して呼び出し元に戻る
+    vlm_analyzer_.SetYieldCallback([this](){
+      assert(yield_ != nullptr);
+      (*yield_)();
+    }, node_quantum);
+
+    // 初回: coroutineを生成すると最初の中断(or 解図終了)まで実行される
+    boost::coroutines2::fixedsize_stack stack_allocator(kSlicedSolverStackSize);
+
+    solve_coroutine_.reset(new SolveCoroutine::pull_type(stack_allocator, [this](SolveCoroutine::push_type &yield){
+      yield_ = &yield;
+      vlm_analyzer_.Solve(vlm_search_, &vlm_result_);
+    }));
+  }else{
+    // 中断中はyield_callback_の呼び出し中のため、呼び出し先は変更せず間隔のみ更新する
+    vlm_analyzer_.SetYieldInterval(node_quantum);
+    (*solve_coroutine_)();
+  }
+
+  is_finished_ = !(*solve_coroutine_);
+
+  if(is_finished_){
+    vlm_analyzer_.SetYieldCallback(nullptr, 0);
+    yield_ = nullptr;
+  }
+
+  return is_finished_;
+}
+
+const bool VLMSlicedSolver::IsFinished() const
+{
+  return is_finished_;
+}
+
+const VLMResult& VLMSlicedSolver::GetResult() const
+{
+  assert(is_finished_);
+  return vlm_result_;
+}
+
+const VLMAnalyzer& VLMSlicedSolver::GetAnalyzer() const
+{
+  return vlm_analyzer_;
+}
+
+}   // namespace realcore
@@ -6,8 +6,20 @@ using namespace std;
 using namespace realcore;
 
 VLMTable::VLMTable(const size_t table_space, const bool lock_control)
-: hash_table_(table_space, lock_control)
+: hash_table_(table_space, lock_control), entry_count_(0), lock_control_(lock_control)
+{
+}
+
+namespace{
+//! @brief 登録データの詰まないことを確認済の深さを返す
+const std::int16_t GetDisprovedDepth(const VLMTableData &table_data)
 {
+  if(IsVLMWeakDisproved(table_data.search_value)){
+    return std::max<std::int16_t>(table_data.disproved_depth, GetVLMDepth(table_data.search_value));
+  }
+
+  return table_data.disproved_depth;
+}
 }
 
 void VLMTable::Upsert(const HashValue hash_value, const BitBoard &bit_board, const VLMSearchValue search_value)
@@ -21,27 +33,81 @@ void VLMTable::Upsert(const HashValue hash_value, const BitBoard &bit_board, con
   VLMTableData in_table_data;
   const bool is_conflict = hash_table_.IsConflict(hash_value, &in_table_data);
 
+  if(!is_conflict){
+    entry_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // 同一局面の詰まないことを確認済の深さを引き継ぐ
+  bool is_same_position = is_conflict && in_table_data.hash_value == hash_value;
+
+#if kUseExactBoardInfo
+  is_same_position &= in_table_data.board == table_data.board;
+#endif
+
+  if(is_same_position){
+    table_data.disproved_depth = std::max(GetDisprovedDepth(table_data), GetDisprovedDepth(in_table_data));
+  }
+
   if(IsVLMProved(search_value)){
     // 詰むデータの登録
-    // 登録先にすでに詰むデータが記録されている場合は別テーブルに登録する
+    // 登録先に同一局面の詰むデータが記録されている場合は短い詰みのみ上書きする
+    if(is_same_position && IsVLMProved(in_table_data.search_value)){
+      if(search_value > in_table_data.search_value){
+        hash_table_.Upsert(hash_value, table_data);
+      }
+
+      return;
+    }
+
+    // 登録先に別局面の詰むデータが記録されている場合は別テーブルに登録する
     if(is_conflict && IsVLMProved(in_table_data.search_value)){
+      std::unique_lock<std::mutex> lock(proved_data_mutex_, std::defer_lock);
+
+      if(lock_control_){
+        lock.lock();
+      }
+
       proved_data_list_.emplace_back(table_data);
     }else{
       hash_table_.Upsert(hash_value, table_data);
     }
   }else{
     // 詰まないデータの登録
-    // 登録先にすでに詰むデータが記録されている場合は登録を行わない
+    // 登録先に同一局面の詰むデータが記録されている場合は詰まないことを確認済の深さのみ更新する
+    if(is_same_position && IsVLMProved(in_table_data.search_value)){
+      if(table_data.disproved_depth > in_table_data.disproved_depth){
+        in_table_data.disproved_depth = table_data.disproved_depth;
+        hash_table_.Upsert(hash_value, in_table_data);
+      }
+
+      return;
+    }
+
+    // 登録先に別局面の詰むデータが記録されている場合は登録を行わない
     if(is_conflict && IsVLMProved(in_table_data.search_value)){
       return;
     }
 
+    // 同一局面でより深い深さの弱意の不詰を確認済の場合はその深さで登録する
+    if(is_same_position && IsVLMWeakDisproved(search_value)){
+      table_data.search_value = GetVLMWeakDisprovedSearchValue(table_data.disproved_depth);
+    }
+
     hash_table_.Upsert(hash_value, table_data);
   }
 }
 
 const bool VLMTable::find(const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value) const
 {
+  std::int16_t disproved_depth = 0;
+  return find(hash_value, bit_board, search_value, &disproved_depth);
+}
+
+const bool VLMTable::find(const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value, std::int16_t * const disproved_depth) const
+{
+  assert(search_value != nullptr);
+  assert(disproved_depth != nullptr);
+
   VLMTableData table_data;
   auto find_result = hash_table_.IsConflict(hash_value, &table_data);
 
@@ -54,6 +120,11 @@ const bool VLMTable::find(const HashValue hash_value, const BitBoard &bit_board,
     if(IsVLMProved(table_data.search_value)){
       // 別のHash値の詰むデータが登録されているため別テーブルに記録されている可能性がある
       find_result = false;
+      std::unique_lock<std::mutex> lock(proved_data_mutex_, std::defer_lock);
+
+      if(lock_control_){
+        lock.lock();
+      }
 
       for(const auto &proved_data : proved_data_list_){
         if(proved_data.hash_value == hash_value){
@@ -85,12 +156,61 @@ const bool VLMTable::find(const HashValue hash_value, const BitBoard &bit_board,
 #endif
 
   *search_value = table_data.search_value;
+  *disproved_depth = GetDisprovedDepth(table_data);
   return true;
 }
 
+const double VLMTable::GetFillRate() const
+{
+  const auto table_size = hash_table_.size();
+
+  if(table_size == 0){
+    return 0;
+  }
+
+  return std::min(1.0, static_cast<double>(entry_count_.load(std::memory_order_relaxed)) / table_size);
+}
+
 void VLMTable::Initialize(){
   proved_data_list_.clear();
   hash_table_.Initialize();
+  entry_count_.store(0, std::memory_order_relaxed);
+}
+
+VCFTable::VCFTable(const size_t table_space, const bool lock_control)
+: hash_table_(table_space, lock_control)
+{
+}
+
+void VCFTable::Upsert(const HashValue hash_value, const std::int16_t disproved_depth)
+{
+  VCFTableData in_table_data;
+  const bool is_conflict = hash_table_.IsConflict(hash_value, &in_table_data);
+
+  if(is_conflict && in_table_data.hash_value == hash_value && in_table_data.disproved_depth >= disproved_depth){
+    // より深い深さで確認済
+    return;
+  }
+
+  VCFTableData table_data(hash_value, disproved_depth);
+  hash_table_.Upsert(hash_value, table_data);
+}
+
+const bool VCFTable::find(const HashValue hash_value, std::int16_t * const disproved_depth) const
+{
+  VCFTableData table_data;
+  const auto find_result = hash_table_.IsConflict(hash_value, &table_data);
+
+  if(!find_result || table_data.hash_value != hash_value){
+    return false;
+  }
+
+  *disproved_depth = table_data.disproved_depth;
+  return true;
+}
+
+void VCFTable::Initialize(){
+  hash_table_.Initialize();
 }
 
 std::string VLMTable::GetDefinitionInfo() const
@@ -2,6 +2,11 @@
 #define VLM_ANALYZER_INL_H
 
 #include <numeric>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+#include <boost/thread.hpp>
 
 #include "VLMAnalyzer.h"
 
@@ -54,14 +59,14 @@ VLMSearchValue VLMAnalyzer::SolveOR(const VLMSearch &vlm_search, VLMResult * con
 
   search_manager_.AddNode();
 
-  if(search_manager_.IsTerminate()){
+  if(IsSearchTerminate()){
     return kVLMWeakDisprovedUB;
   }
 
   // 置換表をチェック
   const auto hash_value = CalcHashValue(board_move_sequence_);
   VLMSearchValue table_value = 0;
-  const bool is_registered = vlm_table_->find(hash_value, bit_board_, &table_value);
+  const bool is_registered = FindSearchValue(vlm_search, hash_value, &table_value);
 
   if(is_registered){
     if(IsVLMProved(table_value) || IsVLMDisproved(table_value)){
@@ -97,28 +102,103 @@ VLMSearchValue VLMAnalyzer::SolveOR(const VLMSearch &vlm_search, VLMResult * con
     return search_value;
   }
 
+  if(vlm_search.shallow_solver && vlm_search.is_search && vlm_search.remain_depth == 3 && !IsRootNode()){
+    // 残り深さ3は専用ルーチンで探索する(root nodeは前回の反復の結果を更新するため通常探索する)
+    return SolveShallowOR<P>(vlm_search, hash_value);
+  }
+
   // 候補手生成
   MoveList candidate_move;
   GetCandidateMoveOR<P>(vlm_search, &candidate_move);
 
+  if(IsRootNode()){
+    // 前回の反復の結果を引き継ぐ
+    ReorderRootCandidateMove(*vlm_result, &candidate_move);
+  }
+
   // 展開
   VLMSearch child_vlm_search = vlm_search;
   constexpr PlayerTurn Q = GetOpponentTurn(P);
   VLMSearchValue or_node_value = kVLMStrongDisproved;
+  MovePosition proof_move = kNullMove;    // 最短で詰む手
+  MoveBitSet proved_move_bit;             // 詰むことを確認した手(順序付けの区分の実績用)
   bool is_search_all_candidate = vlm_search.detect_dual_solution;   // 余詰探索用に全候補手を展開するかのフラグ
 
   // 多重反復深化
   const VLMSearchDepth max_child_depth = vlm_search.remain_depth - 1;
-  const VLMSearchDepth min_child_depth = is_registered ? max_child_depth : 2;
+  VLMSearchDepth min_child_depth = is_registered ? max_child_depth : 2;
+
+  if(is_registered && vlm_search.shortest_solution){
+    // 最短手順モードでは詰まないことを確認済の深さの次の深さから展開する(最初に見つかる詰みが最短となる)
+    min_child_depth = std::max<VLMSearchDepth>(2, GetVLMDepth(table_value) + 1);
+
+    if((max_child_depth - min_child_depth) % 2 != 0){
+      min_child_depth++;
+    }
+
+    min_child_depth = std::min(min_child_depth, max_child_depth);
+  }
+
+  // VCFの事前チェック(余詰探索で全候補手の展開が必要な場合と、前回の反復の結果を更新するroot nodeでは行わない)
+  const bool use_vcf = vlm_search.vcf_precheck && vlm_search.is_search && !is_search_all_candidate && !IsRootNode();
+
+  // 展開する候補手: 浅い深さで強意の不詰 or 詰みとなった子ノードは深い深さでは展開しない
+  MoveList search_move = candidate_move;
+
+  // 四の防手が1手に限られるAND nodeは続けて展開する(root nodeの子ノードは前回の反復の結果を更新するため通常探索する)
+  const bool use_forced_move_extension = vlm_search.forced_move_extension && !IsRootNode();
 
   for(VLMSearchDepth child_depth=min_child_depth; child_depth<=max_child_depth; child_depth+=2){
     child_vlm_search.remain_depth = child_depth;
 
-    for(const auto move : candidate_move){
+    if(use_vcf && child_depth + 1 >= kVCFMinDepth){
+      // 浅い深さで詰まないことを確認済のため、VCFが見つかればこの深さでの最短の詰みとなる
+      VLMSearch vcf_search = vlm_search;
+      vcf_search.remain_depth = child_depth + 1;
+      VLMSearchValue vcf_value = kVLMStrongDisproved;
+
+      if(SolveVCF<P>(vcf_search, &vcf_value)){
+        // 置換表への登録はSolveVCFで行っている
+        UpsertShortestBound(vlm_search, hash_value, vcf_value);
+        return vcf_value;
+      }
+    }
+
+    std::vector<std::pair<std::uint64_t, MovePosition>> next_search_move;   // (探索ノード数, 指し手)
+    next_search_move.reserve(search_move.size());
+
+    for(const auto move : search_move){
+      const auto start_node = search_manager_.GetNode();
+
       MakeMove(child_vlm_search, move);
-      VLMSearchValue and_node_value = SolveAND<Q>(child_vlm_search, vlm_result);
+
+      VLMSearchValue and_node_value = kVLMStrongDisproved;
+      MovePosition forced_guard_move;
+
+      if(use_forced_move_extension && IsOpponentFour(&forced_guard_move)){
+        and_node_value = SolveForcedAND<Q>(child_vlm_search, forced_guard_move, vlm_result);
+      }else{
+        and_node_value = SolveAND<Q>(child_vlm_search, vlm_result);
+      }
+
       UndoMove();
 
+      if(!IsVLMProved(and_node_value) && !IsVLMDisproved(and_node_value)){
+        next_search_move.emplace_back(search_manager_.GetNode() - start_node, move);
+      }
+
+      if(IsRootNode() && IsVLMDisproved(and_node_value)){
+        vlm_result->refuted_root_move.set(move);
+      }
+
+      if(IsVLMProved(and_node_value) && and_node_value > or_node_value){
+        proof_move = move;
+      }
+
+      if(IsVLMProved(and_node_value)){
+        proved_move_bit.set(move);
+      }
+
       or_node_value = std::max(or_node_value, and_node_value);
       
       if(is_search_all_candidate && !IsRootNode() && IsVLMProved(or_node_value)){
@@ -135,13 +215,370 @@ VLMSearchValue VLMAnalyzer::SolveOR(const VLMSearch &vlm_search, VLMResult * con
         break;
       }
     }
+
+    // 次の深さでは浅い深さでの探索ノード数が多い手(受け側の防御が難しい手)から展開する
+    std::stable_sort(next_search_move.begin(), next_search_move.end(),
+      [](const std::pair<std::uint64_t, MovePosition> &lhs, const std::pair<std::uint64_t, MovePosition> &rhs){
+        return lhs.first > rhs.first;
+      });
+
+    search_move.clear();
+
+    for(const auto &node_move : next_search_move){
+      search_move += node_move.second;
+    }
+  }
+
+  if(IsRootNode()){
+    // 次の反復(ResumeSolveを含む)ではこの順序で展開する
+    vlm_result->root_move_order = search_move;
   }
 
   const VLMSearchValue search_value = GetSearchValue(or_node_value);
   vlm_table_->Upsert(hash_value, bit_board_, search_value);
+  UpsertShortestBound(vlm_search, hash_value, search_value);
+
+  if(IsVLMProved(search_value)){
+    RecordProofOR(vlm_search, hash_value, search_value, proof_move);
+
+    if(vlm_search.train_move_ordering && vlm_search.is_search && candidate_move.size() >= 2 && proved_move_bit.any()){
+      // 余詰探索で複数の詰む手を確認した場合はすべて実績に加える
+      constexpr MoveOrderingNode node = P == kBlackTurn ? kOrderingORBlack : kOrderingORWhite;
+      UpdateMoveOrderingStat<P>(node, vlm_search, candidate_move, proved_move_bit);
+    }
+  }
+
   return search_value;
 }
 
+template<PlayerTurn P>
+VLMSearchValue VLMAnalyzer::SolveShallowOR(const VLMSearch &vlm_search, const HashValue hash_value)
+{
+  assert(vlm_search.remain_depth == 3);
+
+  // 候補手生成
+  // 残り深さ3で詰むには終端の脅威(四 or 達四点)を生じる必要があるため、四ノビと三を作る手に限る
+  MoveBitSet candidate_move_bit;
+  MovePosition guard_move;
+  const bool is_opponent_four = IsOpponentFour(&guard_move);
+
+  if(is_opponent_four){
+    // 相手に四がある
+    candidate_move_bit.set(guard_move);
+  }else{
+    MoveBitSet forbidden_bit, four_bit, three_bit;
+    GetForbiddenMoveBit(&forbidden_bit);
+    board_move_sequence_.GetOpenMove(forbidden_bit, &candidate_move_bit);
+
+    EnumerateFourMoves<P>(&four_bit);
+    EnumerateSemiThreeMoves<P>(&three_bit);
+    candidate_move_bit &= (four_bit | three_bit);
+  }
+
+  MoveList candidate_move;
+  GetMoveList(candidate_move_bit, &candidate_move);
+
+  // 展開
+  VLMSearch child_vlm_search = vlm_search;
+  child_vlm_search.remain_depth--;
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+  // 生成しない手(脅威のない手)は相手がPassすると弱意の不詰となるAND nodeのため、相手に四がなければ候補手がなくても強意の不詰にはならない
+  VLMSearchValue or_node_value = is_opponent_four ? kVLMStrongDisproved : GetVLMWeakDisprovedSearchValue(child_vlm_search.remain_depth);
+  MovePosition proof_move = kNullMove;    // 最短で詰む手
+
+  constexpr PositionState S = GetPlayerStone(P);
+  const bool is_black_turn = P == kBlackTurn;
+  BitBoard child_bit_board = bit_board_;
+
+  for(const auto move : candidate_move){
+    // 置換表で値が定まる子ノードはBitBoard, Hash値の差分更新のみで評価し、指し手の設定(開放状態の更新)を省略する
+    const auto child_hash_value = CalcHashValue(is_black_turn, move, hash_value);
+    child_bit_board.SetState<S>(move);
+
+    VLMSearchValue and_node_value = 0;
+    const bool is_find = FindSearchValue(child_vlm_search, child_hash_value, child_bit_board, &and_node_value);
+
+    child_bit_board.SetState<kOpenPosition>(move);
+
+    if(is_find && (IsVLMProved(and_node_value) || IsVLMDisproved(and_node_value) || GetVLMDepth(and_node_value) >= child_vlm_search.remain_depth)){
+      // SolveShallowANDの置換表チェックと同じ条件
+      search_manager_.AddNode();
+    }else{
+      MakeMove(child_vlm_search, move);
+      and_node_value = SolveShallowAND<Q>(child_vlm_search);
+      UndoMove();
+    }
+
+    if(IsVLMProved(and_node_value) && and_node_value > or_node_value){
+      proof_move = move;
+    }
+
+    or_node_value = std::max(or_node_value, and_node_value);
+
+    // 余詰探索を行う場合は証明木取得のためすべての詰む手を置換表に登録する
+    if(!vlm_search.detect_dual_solution && IsVLMProved(or_node_value)){
+      break;
+    }
+  }
+
+  const VLMSearchValue search_value = GetSearchValue(or_node_value);
+  vlm_table_->Upsert(hash_value, bit_board_, search_value);
+
+  if(IsVLMProved(search_value)){
+    RecordProofOR(vlm_search, hash_value, search_value, proof_move);
+  }
+
+  return search_value;
+}
+
+template<PlayerTurn P>
+VLMSearchValue VLMAnalyzer::SolveShallowAND(const VLMSearch &vlm_search)
+{
+  assert(vlm_search.remain_depth == 2);
+
+  search_manager_.AddNode();
+
+  if(IsSearchTerminate()){
+    return kVLMWeakDisprovedUB;
+  }
+
+  // 置換表をチェック
+  const auto hash_value = CalcHashValue(board_move_sequence_);
+  VLMSearchValue table_value = 0;
+  const bool is_registered = FindSearchValue(vlm_search, hash_value, &table_value);
+
+  if(is_registered){
+    if(IsVLMProved(table_value) || IsVLMDisproved(table_value) || GetVLMDepth(table_value) >= vlm_search.remain_depth){
+      return table_value;
+    }
+  }else{
+    // 初回訪問時のみ終端チェックを行う
+    MovePosition terminating_move;
+
+    if(TerminateCheck(&terminating_move)){
+      // 終端
+      vlm_table_->Upsert(hash_value, bit_board_, kVLMStrongDisproved);
+      return kVLMStrongDisproved;
+    }
+  }
+
+  // 候補手生成
+  MoveList candidate_move;
+  const auto is_terminate_guard = GetCandidateMoveAND<P>(vlm_search, &candidate_move);
+
+  if(!is_terminate_guard){
+    // 相手に１手勝ちがない -> Passすると弱意の不詰になる
+    static constexpr VLMSearchDepth depth = 2;
+    constexpr VLMSearchValue search_value = GetVLMWeakDisprovedSearchValue(depth);
+
+    vlm_table_->Upsert(hash_value, bit_board_, search_value);
+    return search_value;
+  }
+
+  // 展開: 残り深さ1のOR nodeは終端チェックのみで値が定まる
+  const VLMSearchValue and_node_value = SolveDepthTwoGuard<P>(vlm_search, hash_value, candidate_move);
+  const VLMSearchValue search_value = GetSearchValue(and_node_value);
+  vlm_table_->Upsert(hash_value, bit_board_, search_value);
+
+  if(IsVLMProved(search_value)){
+    RecordProofAND(vlm_search, hash_value, search_value, candidate_move);
+  }
+
+  return search_value;
+}
+
+template<PlayerTurn P>
+VLMSearchValue VLMAnalyzer::SolveDepthTwoGuard(const VLMSearch &vlm_search, const HashValue hash_value, const MoveList &guard_move)
+{
+  assert(vlm_search.remain_depth == 2);
+
+  VLMSearch child_vlm_search = vlm_search;
+  child_vlm_search.remain_depth--;
+
+  constexpr PositionState S = GetPlayerStone(P);
+  const bool is_black_turn = P == kBlackTurn;
+  BitBoard child_bit_board = bit_board_;
+  VLMSearchValue and_node_value = kVLMProvedUB;
+
+  // 相手に四がなければ、四ノビとなる防手の後は相手に五がなく四を止める必要があるため終端しない
+  // 全防手について四ノビとなるかを一括で求めておき、該当する防手は指し手を設定せずに弱意の不詰とする
+  MoveBitSet counter_four_bit;
+  MovePosition opponent_five_move;
+
+  if(!IsOpponentFour(&opponent_five_move)){
+    EnumerateFourMoves<P>(&counter_four_bit);
+  }
+
+  for(const auto move : guard_move){
+    search_manager_.AddNode();
+
+    VLMSearchValue or_node_value = 0;
+    bool is_find = false;
+
+    if(move != kNullMove){
+      // 置換表に登録済の防手はBitBoard, Hash値の差分更新のみで評価し、指し手の設定(開放状態の更新)を省略する
+      const auto child_hash_value = CalcHashValue(is_black_turn, move, hash_value);
+      child_bit_board.SetState<S>(move);
+
+      is_find = FindSearchValue(child_vlm_search, child_hash_value, child_bit_board, &or_node_value);
+
+      if(!is_find && counter_four_bit[move]){
+        constexpr VLMSearchDepth depth = 1;
+        or_node_value = GetVLMWeakDisprovedSearchValue(depth);
+        vlm_table_->Upsert(child_hash_value, child_bit_board, or_node_value);
+        is_find = true;
+      }
+
+      child_bit_board.SetState<kOpenPosition>(move);
+    }
+
+    if(is_find){
+      depth_two_probe_count_++;
+    }else{
+      depth_two_move_count_++;
+      MakeMove(child_vlm_search, move);
+
+      const auto child_hash_value = CalcHashValue(board_move_sequence_);
+      const bool is_probed = move != kNullMove;   // Pass以外は差分更新で置換表を参照済
+
+      if(is_probed || !FindSearchValue(child_vlm_search, child_hash_value, &or_node_value)){
+        constexpr VLMSearchDepth depth = 1;
+        MovePosition terminating_move;
+        const bool is_terminate = TerminateCheck(&terminating_move);
+
+        or_node_value = is_terminate ? GetVLMProvedSearchValue(depth) : GetVLMWeakDisprovedSearchValue(depth);
+        vlm_table_->Upsert(child_hash_value, bit_board_, or_node_value);
+      }
+
+      UndoMove();
+    }
+
+    and_node_value = std::min(and_node_value, or_node_value);
+
+    if(!IsVLMProved(or_node_value)){
+      break;
+    }
+  }
+
+  return and_node_value;
+}
+
+template<PlayerTurn P>
+const bool VLMAnalyzer::SolveVCF(const VLMSearch &vlm_search, VLMSearchValue * const search_value)
+{
+  assert(search_value != nullptr);
+
+  search_manager_.AddNode();
+
+  if(IsSearchTerminate()){
+    return false;
+  }
+
+  // 置換表をチェック
+  const auto hash_value = CalcHashValue(board_move_sequence_);
+  VLMSearchValue table_value = 0;
+
+  if(vlm_table_->find(hash_value, bit_board_, &table_value) && IsVLMProved(table_value) && GetVLMDepth(table_value) <= vlm_search.remain_depth){
+    *search_value = table_value;
+    return true;
+  }
+
+  std::int16_t vcf_disproved_depth = 0;
+
+  if(vcf_table_->find(hash_value, &vcf_disproved_depth) && vcf_disproved_depth >= vlm_search.remain_depth){
+    return false;
+  }
+
+  MovePosition terminating_move;
+  const bool is_terminate = TerminateCheck(&terminating_move);
+
+  if(is_terminate){
+    // 終端
+    constexpr VLMSearchDepth depth = 1;
+    *search_value = GetVLMProvedSearchValue(depth);
+    vlm_table_->Upsert(hash_value, bit_board_, *search_value);
+    return true;
+  }
+
+  if(vlm_search.remain_depth < 3){
+    vcf_table_->Upsert(hash_value, vlm_search.remain_depth);
+    return false;
+  }
+
+  // 候補手生成: 四ノビのみ
+  MoveBitSet four_bit;
+  EnumerateFourMoves<P>(&four_bit);
+
+  MovePosition guard_move;
+
+  if(IsOpponentFour(&guard_move)){
+    // 相手に四がある場合は防手が四ノビになる場合のみ
+    const bool is_four_guard = four_bit[guard_move];
+    four_bit.reset();
+
+    if(is_four_guard){
+      four_bit.set(guard_move);
+    }
+  }else if(P == kBlackTurn){
+    MoveBitSet forbidden_bit;
+    GetForbiddenMoveBit(&forbidden_bit);
+    four_bit &= ~forbidden_bit;
+  }
+
+  MoveList candidate_move;
+  GetMoveList(four_bit, &candidate_move);
+
+  // 展開: AND nodeの防手は四の防手に限られる
+  VLMSearch and_vlm_search = vlm_search;
+  and_vlm_search.remain_depth--;
+
+  VLMSearch or_vlm_search = vlm_search;
+  or_vlm_search.remain_depth -= 2;
+
+  for(const auto move : candidate_move){
+    MakeMove(and_vlm_search, move);
+
+    bool is_proved = false;
+    MovePosition opponent_terminating_move, opponent_guard_move;
+
+    if(!TerminateCheck(&opponent_terminating_move) && IsOpponentFour(&opponent_guard_move)){
+      MakeMove(or_vlm_search, opponent_guard_move);
+
+      VLMSearchValue or_node_value = kVLMStrongDisproved;
+      is_proved = SolveVCF<P>(or_vlm_search, &or_node_value);
+
+      UndoMove();
+
+      if(is_proved){
+        // AND nodeの詰みを登録する
+        const auto and_node_value = GetSearchValue(or_node_value);
+        const auto and_hash_value = CalcHashValue(board_move_sequence_);
+        vlm_table_->Upsert(and_hash_value, bit_board_, and_node_value);
+
+        MoveList guard_move_list;
+        guard_move_list += opponent_guard_move;
+        RecordProofAND(vlm_search, and_hash_value, and_node_value, guard_move_list);
+
+        *search_value = GetSearchValue(and_node_value);
+      }
+    }
+
+    UndoMove();
+
+    if(is_proved){
+      vlm_table_->Upsert(hash_value, bit_board_, *search_value);
+      RecordProofOR(vlm_search, hash_value, *search_value, move);
+      return true;
+    }
+  }
+
+  if(!IsSearchTerminate()){
+    vcf_table_->Upsert(hash_value, vlm_search.remain_depth);
+  }
+
+  return false;
+}
+
 template<PlayerTurn P>
 VLMSearchValue VLMAnalyzer::SolveAND(const VLMSearch &vlm_search, VLMResult * const vlm_result)
 {
@@ -149,14 +586,14 @@ VLMSearchValue VLMAnalyzer::SolveAND(const VLMSearch &vlm_search, VLMResult * co
 
   search_manager_.AddNode();
 
-  if(search_manager_.IsTerminate()){
+  if(IsSearchTerminate()){
     return kVLMWeakDisprovedUB;
   }
 
   // 置換表をチェック
   const auto hash_value = CalcHashValue(board_move_sequence_);
   VLMSearchValue table_value = 0;
-  const bool is_registered = vlm_table_->find(hash_value, bit_board_, &table_value);
+  const bool is_registered = FindSearchValue(vlm_search, hash_value, &table_value);
 
   if(is_registered){
     if(IsVLMProved(table_value) || IsVLMDisproved(table_value)){
@@ -195,15 +632,79 @@ VLMSearchValue VLMAnalyzer::SolveAND(const VLMSearch &vlm_search, VLMResult * co
     return search_value;
   }
 
+  if(vlm_search.shallow_solver && vlm_search.remain_depth == 2 && search_sequence_.size() != 1){
+    // 残り深さ1のOR nodeは終端チェックのみで値が定まるため、Simulation等を行わずに評価する
+    // (root nodeの子ノードは前回の反復の最善の防手を更新するため通常の展開を行う)
+    const VLMSearchValue search_value = GetSearchValue(SolveDepthTwoGuard<P>(vlm_search, hash_value, candidate_move));
+    vlm_table_->Upsert(hash_value, bit_board_, search_value);
+
+    if(IsVLMProved(search_value)){
+      RecordProofAND(vlm_search, hash_value, search_value, candidate_move);
+    }
+
+    return search_value;
+  }
+
   // 展開
   VLMSearch child_vlm_search = vlm_search;
   child_vlm_search.remain_depth--;
   constexpr PlayerTurn Q = GetOpponentTurn(P);
   VLMSearchValue and_node_value = kVLMProvedUB;
   MoveTree proof_tree;
+  MoveList proved_move;   // 詰みを確認した防手(影響領域外のため枝刈りした防手を除く)
+
+  // 影響領域による枝刈り: 相手に終端手がない場合はPassを先頭で展開し、Passの証明木の影響領域外の防手を枝刈りする
+  const bool use_relevance_zone = vlm_search.relevance_zone_pruning && !is_terminate_guard;
+  bool is_relevance_zone = false;
+  MoveBitSet relevance_zone_bit;
+
+  if(use_relevance_zone && candidate_move.size() >= 2 && candidate_move[0] != kNullMove){
+    MoveList pass_first_move;
+    pass_first_move += kNullMove;
+
+    for(const auto move : candidate_move){
+      if(move != kNullMove){
+        pass_first_move += move;
+      }
+    }
+
+    candidate_move = pass_first_move;
+  }
+
+  const bool is_root_child = search_sequence_.size() == 1;
+  const auto best_defense_it = is_root_child ? vlm_result->best_defense.find(search_sequence_[0]) : vlm_result->best_defense.end();
+  const auto start_node = search_manager_.GetNode();
+  std::uint64_t expanded_move_count = 0;    // 展開した防手の数(影響領域外のため枝刈りした防手を除く)
+
+  if(best_defense_it != vlm_result->best_defense.end()){
+    // 前回の反復で詰みを防いだ防手を先頭で展開する
+    const MovePosition best_defense = best_defense_it->second;
+    MoveList best_defense_first_move;
+
+    for(const auto move : candidate_move){
+      if(move == best_defense){
+        best_defense_first_move += move;
+      }
+    }
+
+    for(const auto move : candidate_move){
+      if(move != best_defense){
+        best_defense_first_move += move;
+      }
+    }
+
+    candidate_move = best_defense_first_move;
+  }
 
   for(const auto move : candidate_move){
+    if(is_relevance_zone && !relevance_zone_bit[move]){
+      // 影響領域外の防手はPassと同一手順で詰む
+      relevance_zone_prune_count_++;
+      continue;
+    }
+
     MakeMove(child_vlm_search, move);
+    expanded_move_count++;
 
     VLMSearchValue or_node_value = kVLMStrongDisproved;
 
@@ -214,18 +715,42 @@ VLMSearchValue VLMAnalyzer::SolveAND(const VLMSearch &vlm_search, VLMResult * co
     simulation_check &= !vlm_search.detect_dual_solution
        || (vlm_search.detect_dual_solution && proof_tree.depth() < static_cast<size_t>(child_vlm_search.remain_depth));
 
+    // (iii)Simulationの成功実績から効果が見込める
+    if(simulation_check && vlm_search.adaptive_simulation){
+      simulation_check = IsSimulationEffective(child_vlm_search.remain_depth, proof_tree.depth(), &simulation_skip_count_);
+    }
+
     if(simulation_check){
       // 証明木が存在する場合はSimulationを行う
       VLMSearch vlm_simulation = child_vlm_search;
       vlm_simulation.is_search = false;
       
+      const auto simulation_start_node = search_manager_.GetNode();
       or_node_value = SimulationOR<Q>(vlm_simulation, kCheckVLMTable, &proof_tree);
       search_manager_.AddSimulationResult(IsVLMProved(or_node_value));
+
+      const auto simulation_node = search_manager_.GetNode() - simulation_start_node;
+      UpdateSimulationStat(child_vlm_search.remain_depth, proof_tree.depth(), IsVLMProved(or_node_value), simulation_node);
+
+      if(vlm_search.shortest_solution && IsVLMProved(or_node_value) && GetVLMDepth(or_node_value) >= 5){
+        // Simulationの詰みは最短とは限らないため、2手短い深さで詰むかを探索して上限を狭める
+        VLMSearch shorter_vlm_search = child_vlm_search;
+        shorter_vlm_search.remain_depth = GetVLMDepth(or_node_value) - 2;
+
+        const auto shorter_value = SolveOR<Q>(shorter_vlm_search, vlm_result);
+
+        // 詰まない場合は2手短い深さで詰まないことが置換表に登録される
+        if(IsVLMProved(shorter_value)){
+          or_node_value = shorter_value;
+        }
+      }
     }
 
     if(!IsVLMProved(or_node_value)){
       // Simulationをしなかった or 失敗した場合は通常探索を行う
+      const auto solve_start_node = search_manager_.GetNode();
       or_node_value = SolveOR<Q>(child_vlm_search, vlm_result);
+      UpdateSolveStat(child_vlm_search.remain_depth, search_manager_.GetNode() - solve_start_node);
 
       // Simulation用証明木の取得フラグ
       // (i)詰みがある
@@ -234,23 +759,109 @@ VLMSearchValue VLMAnalyzer::SolveAND(const VLMSearch &vlm_search, VLMResult * co
       bool get_proof_tree = IsVLMProved(or_node_value) && GetVLMDepth(or_node_value) >= 3 &&
         (!vlm_search.detect_dual_solution || (vlm_search.detect_dual_solution && GetVLMDepth(or_node_value) < child_vlm_search.remain_depth));
 
+      // (iv)取得した証明木でのSimulationに効果が見込める(Simulationをしない証明木の取得は不要なため)
+      if(get_proof_tree && vlm_search.adaptive_simulation){
+        get_proof_tree = IsSimulationEffective(child_vlm_search.remain_depth, GetVLMDepth(or_node_value), &proof_tree_skip_count_);
+      }
+
       if(get_proof_tree){
         const auto is_generated = GetProofTree(&proof_tree);
         search_manager_.AddGetProofTreeResult(is_generated);
       }
     }
 
+    // 影響領域の取得条件
+    // (i)Passで詰む
+    // (ii)余詰探索なし or 余詰探索あり かつ 弱防の変化(Simulation条件と同様)
+    MoveTree pass_proof_tree;
+    bool get_relevance_zone = use_relevance_zone && move == kNullMove && IsVLMProved(or_node_value) &&
+      (!vlm_search.detect_dual_solution || GetVLMDepth(or_node_value) < child_vlm_search.remain_depth);
+
+    if(get_relevance_zone && proof_tree.empty()){
+      // Simulation用に取得していない場合は影響領域用に証明木を取得する
+      get_relevance_zone = GetProofTree(&pass_proof_tree);
+    }
+
     UndoMove();
 
+    if(get_relevance_zone){
+      GetRelevanceZone<P>(proof_tree.empty() ? &pass_proof_tree : &proof_tree, &relevance_zone_bit);
+      is_relevance_zone = true;
+    }
+
     and_node_value = std::min(and_node_value, or_node_value);
 
     if(!IsVLMProved(or_node_value)){
+      if(is_root_child && !IsSearchInterrupted()){
+        // 次の反復(ResumeSolveを含む)では先頭で展開する
+        vlm_result->best_defense[search_sequence_[0]] = move;
+      }
+
+      if(!IsSearchInterrupted()){
+        // 探索の打ち切りによる不詰は除く
+        refutation_count_++;
+        refutation_node_ += search_manager_.GetNode() - start_node;
+        refutation_move_count_ += expanded_move_count;
+
+        if(vlm_search.train_move_ordering && vlm_search.is_search && vlm_search.remain_depth >= 4 && candidate_move.size() >= 2){
+          constexpr MoveOrderingNode node = P == kBlackTurn ? kOrderingANDBlack : kOrderingANDWhite;
+          MoveBitSet refuted_move_bit;
+          refuted_move_bit.set(move);
+          UpdateMoveOrderingStat<P>(node, vlm_search, candidate_move, refuted_move_bit);
+        }
+      }
+
       break;
     }
+
+    proved_move += move;
   }
 
   const VLMSearchValue search_value = GetSearchValue(and_node_value);
   vlm_table_->Upsert(hash_value, bit_board_, search_value);
+  UpsertShortestBound(vlm_search, hash_value, search_value);
+
+  if(IsVLMProved(search_value)){
+    RecordProofAND(vlm_search, hash_value, search_value, proved_move);
+  }
+
+  return search_value;
+}
+
+template<PlayerTurn P>
+VLMSearchValue VLMAnalyzer::SolveForcedAND(const VLMSearch &vlm_search, const MovePosition guard_move, VLMResult * const vlm_result)
+{
+  assert(vlm_result != nullptr);
+
+  MovePosition terminating_move;
+  const bool is_terminate = TerminateCheck(&terminating_move);
+
+  if(is_terminate){
+    // 終端
+    return kVLMStrongDisproved;
+  }
+
+  // 展開: 子ノードのOR nodeで置換表の参照, ノード数の計上を行う
+  VLMSearch child_vlm_search = vlm_search;
+  child_vlm_search.remain_depth--;
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  MakeMove(child_vlm_search, guard_move);
+  const VLMSearchValue or_node_value = SolveOR<Q>(child_vlm_search, vlm_result);
+  UndoMove();
+
+  const VLMSearchValue search_value = GetSearchValue(or_node_value);
+
+  if(IsVLMProved(search_value)){
+    const auto hash_value = CalcHashValue(board_move_sequence_);
+    vlm_table_->Upsert(hash_value, bit_board_, search_value);
+    UpsertShortestBound(vlm_search, hash_value, search_value);
+
+    MoveList proved_move;
+    proved_move += guard_move;
+    RecordProofAND(vlm_search, hash_value, search_value, proved_move);
+  }
+
   return search_value;
 }
 
@@ -270,7 +881,7 @@ void VLMAnalyzer::GetCandidateMoveOR(const VLMSearch &vlm_search, MoveList * con
 
   // 全空点を生成する
   MoveBitSet forbidden_bit, candidate_move_bit;
-  EnumerateForbiddenMoves(&forbidden_bit);
+  GetForbiddenMoveBit(&forbidden_bit);
 
   board_move_sequence_.GetOpenMove(forbidden_bit, &candidate_move_bit);
 
@@ -298,7 +909,7 @@ bool VLMAnalyzer::GetCandidateMoveAND(const VLMSearch &vlm_search, MoveList * co
   MoveBitSet guard_move_bit;
   const bool terminate_threat = GetTerminateGuard(&guard_move_bit);
   MoveBitSet forbidden_bit;
-  EnumerateForbiddenMoves(&forbidden_bit);
+  GetForbiddenMoveBit(&forbidden_bit);
   
   if(terminate_threat)
   {
@@ -314,7 +925,11 @@ bool VLMAnalyzer::GetCandidateMoveAND(const VLMSearch &vlm_search, MoveList * co
   }
 
   if(vlm_search.is_search && vlm_search.remain_depth >= 4){
-    MoveOrderingAND<P>(&guard_move_bit, candidate_move);
+    if(vlm_search.threat_move_ordering){
+      MoveOrderingThreatAND<P>(&guard_move_bit, candidate_move);
+    }else{
+      MoveOrderingAND<P>(vlm_search, &guard_move_bit, candidate_move);
+    }
   }else{
     // Passが先頭で生成され、Null move pruningを行うことに相当する
     GetMoveList(guard_move_bit, candidate_move);
@@ -324,28 +939,229 @@ bool VLMAnalyzer::GetCandidateMoveAND(const VLMSearch &vlm_search, MoveList * co
 }
 
 template<PlayerTurn P>
-void VLMAnalyzer::MoveOrderingAND(MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
+void VLMAnalyzer::MoveOrderingOR(const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
+{
+  const MoveOrderingTable &ordering_table = P == kBlackTurn ? kMoveOrderingORBlack : kMoveOrderingORWhite;
+  MoveOrderingByTable<P>(ordering_table, vlm_search, candidate_move_bit, candidate_move);
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::MoveOrderingAND(const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
+{
+  const MoveOrderingTable &ordering_table = P == kBlackTurn ? kMoveOrderingANDBlack : kMoveOrderingANDWhite;
+  MoveOrderingByTable<P>(ordering_table, vlm_search, candidate_move_bit, candidate_move);
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::MoveOrderingByTable(const MoveOrderingTable &ordering_table, const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
 {
   assert(candidate_move != nullptr);
   assert(candidate_move->empty());
 
+  VLMMoveOrderingBit ordering_bit;
+
+  for(const auto category : ordering_table){
+    if(category == kOrderingNone){
+      break;
+    }
+
+    if(vlm_search.remain_depth < GetMoveOrderingMinDepth(category)){
+      continue;
+    }
+
+    SelectMove(GetMoveOrderingBit<P>(category, &ordering_bit), candidate_move_bit, candidate_move);
+  }
+
+  // 残りの手をすべて生成
+  GetMoveList(*candidate_move_bit, candidate_move);
+}
+
+template<PlayerTurn P>
+const MoveBitSet& VLMAnalyzer::GetMoveOrderingBit(const MoveOrderingCategory category, VLMMoveOrderingBit * const ordering_bit) const
+{
+  assert(ordering_bit != nullptr);
+  assert(category < kMoveOrderingCategoryNum);
+
+  MoveBitSet &category_bit = ordering_bit->category_bit[category];
+
+  if(ordering_bit->is_enumerated[category]){
+    return category_bit;
+  }
+
   constexpr PlayerTurn Q = GetOpponentTurn(P);
 
-  // @see doc/02_performance/vlm_analyzer_performance.xlsx, MoveOrderingAND sheet
-  {
-    // 優先度1: 三を作る手
-    MoveBitSet semi_three_move_bit;
-    EnumerateSemiThreeMoves<P>(&semi_three_move_bit);
-    SelectMove(semi_three_move_bit, candidate_move_bit, candidate_move);
+  switch(category){
+  case kOrderingFourThree:
+    category_bit = GetMoveOrderingBit<P>(kOrderingFour, ordering_bit) & GetMoveOrderingBit<P>(kOrderingThree, ordering_bit);
+    break;
+
+  case kOrderingDoubleThree:
+    EnumerateDoubleSemiThreeMoves<P>(&category_bit);
+    break;
+
+  case kOrderingThreatSword:
+    category_bit = GetMoveOrderingBit<P>(kOrderingFour, ordering_bit) | GetMoveOrderingBit<P>(kOrderingThree, ordering_bit);
+    category_bit &= GetMoveOrderingBit<P>(kOrderingSword, ordering_bit);
+    break;
+
+  case kOrderingThreatMise:
+    category_bit = GetMoveOrderingBit<P>(kOrderingFour, ordering_bit) | GetMoveOrderingBit<P>(kOrderingThree, ordering_bit);
+    category_bit &= GetMoveOrderingBit<P>(kOrderingMise, ordering_bit);
+    break;
+
+  case kOrderingMultiMise:
+  case kOrderingMise:
+    // ミセ手と両ミセは同時に列挙する
+    EnumerateMiseMoves<P>(&ordering_bit->category_bit[kOrderingMise], &ordering_bit->category_bit[kOrderingMultiMise]);
+    ordering_bit->is_enumerated[kOrderingMise] = true;
+    ordering_bit->is_enumerated[kOrderingMultiMise] = true;
+    break;
+
+  case kOrderingMiseSword:
+    category_bit = GetMoveOrderingBit<P>(kOrderingMise, ordering_bit) & GetMoveOrderingBit<P>(kOrderingSword, ordering_bit);
+    break;
+
+  case kOrderingSword:
+    EnumeratePointOfSwordMoves<P>(&category_bit);
+    break;
+
+  case kOrderingTwo:
+    EnumerateTwoMoves<P>(&category_bit);
+    break;
+
+  case kOrderingFour:
+    EnumerateFourMoves<P>(&category_bit);
+    break;
+
+  case kOrderingThree:
+    EnumerateSemiThreeMoves<P>(&category_bit);
+    break;
+
+  case kOrderingOpponentFour:
+    EnumerateFourMoves<Q>(&category_bit);
+    break;
+
+  default:
+    assert(false);
+    break;
   }
-  {
-    // 優先度2: 相手の四ノビ点に先着する手
-    MoveBitSet opponent_four_move_bit;
-    EnumerateFourMoves<Q>(&opponent_four_move_bit);
-    SelectMove(opponent_four_move_bit, candidate_move_bit, candidate_move);
+
+  ordering_bit->is_enumerated[category] = true;
+  return category_bit;
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::UpdateMoveOrderingStat(const MoveOrderingNode node, const VLMSearch &vlm_search, const MoveList &candidate_move, const MoveBitSet &selected_move_bit)
+{
+  MoveBitSet candidate_move_bit;
+
+  for(const auto move : candidate_move){
+    candidate_move_bit.set(move);
   }
 
-  GetMoveList(*candidate_move_bit, candidate_move);
+  VLMMoveOrderingBit ordering_bit;
+  MoveOrderingStatTable &stat_table = move_ordering_stat_[node];
+
+  for(size_t i=0; i<kMoveOrderingCategoryNum; i++){
+    const auto category = static_cast<MoveOrderingCategory>(i);
+
+    if(vlm_search.remain_depth < GetMoveOrderingMinDepth(category)){
+      continue;
+    }
+
+    const MoveBitSet &category_bit = GetMoveOrderingBit<P>(category, &ordering_bit);
+
+    stat_table[category].candidate_count += (category_bit & candidate_move_bit).count();
+    stat_table[category].selected_count += (category_bit & selected_move_bit).count();
+  }
+}
+
+inline const MoveOrderingStatTable& VLMAnalyzer::GetMoveOrderingStat(const MoveOrderingNode node) const
+{
+  return move_ordering_stat_[node];
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::MoveOrderingThreatAND(MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const
+{
+  assert(candidate_move != nullptr);
+  assert(candidate_move->empty());
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  MoveBitSet opponent_four_bit, opponent_three_bit, own_four_bit, own_three_bit;
+  EnumerateFourMoves<Q>(&opponent_four_bit);
+  EnumerateSemiThreeMoves<Q>(&opponent_three_bit);
+  EnumerateFourMoves<P>(&own_four_bit);
+  EnumerateSemiThreeMoves<P>(&own_three_bit);
+
+  MoveList move_list;
+  GetMoveList(*candidate_move_bit, &move_list);
+
+  std::vector<std::pair<int, MovePosition>> score_move;   // (推定値, 指し手)
+  score_move.reserve(move_list.size());
+
+  for(const auto move : move_list){
+    int score = 0;
+
+    if(move != kNullMove){
+      const MoveBitSet &neighborhood_bit = GetLineNeighborhood(move);
+      score += kThreatOrderingFourWeight * static_cast<int>((opponent_four_bit & neighborhood_bit).count());
+      score += kThreatOrderingThreeWeight * static_cast<int>((opponent_three_bit & neighborhood_bit).count());
+      score += own_four_bit[move] ? kThreatOrderingOwnFourWeight : 0;
+      score += own_three_bit[move] ? kThreatOrderingOwnThreeWeight : 0;
+    }
+
+    score_move.emplace_back(score, move);
+  }
+
+  std::stable_sort(score_move.begin(), score_move.end(),
+    [](const std::pair<int, MovePosition> &lhs, const std::pair<int, MovePosition> &rhs){
+      return lhs.first > rhs.first;
+    });
+
+  for(const auto &move : score_move){
+    *candidate_move += move.second;
+  }
+
+  candidate_move_bit->reset();
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::GetRelevanceZone(MoveTree * const proof_tree, MoveBitSet * const relevance_zone_bit) const
+{
+  assert(proof_tree != nullptr);
+  assert(relevance_zone_bit != nullptr);
+
+  // 証明木の指し手の直線近傍: 証明木の各局面の四, 三, 終端の判定に影響する位置
+  MoveBitSet proof_tree_move_bit;
+  GetProofTreeMoveBit(proof_tree, &proof_tree_move_bit);
+
+  relevance_zone_bit->reset();
+  AddLineNeighborhood(proof_tree_move_bit, relevance_zone_bit);
+
+  // 黒の三の真偽は達四点の禁手状態に依存するため、影響領域内の黒の四ノビ点の直線近傍も含める
+  MoveBitSet black_four_bit;
+  EnumerateFourMoves<kBlackTurn>(&black_four_bit);
+  black_four_bit &= *relevance_zone_bit;
+  AddLineNeighborhood(black_four_bit, relevance_zone_bit);
+
+  // 受け側の石の直線近傍の手は受け側の四ノビ点(証明木のAND nodeでの防手)を新たに生じさせうるため含める
+  MoveBitSet defender_stone_bit;
+  const size_t defender_parity = P == kBlackTurn ? 0 : 1;
+
+  for(size_t i=defender_parity, size=board_move_sequence_.size(); i<size; i+=2){
+    const auto move = board_move_sequence_[i];
+
+    if(move != kNullMove){
+      defender_stone_bit.set(move);
+    }
+  }
+
+  AddLineNeighborhood(defender_stone_bit, relevance_zone_bit);
+
+  // Passは枝刈りの基準のため常に展開対象とする
+  relevance_zone_bit->set(kNullMove);
 }
 
 inline const SearchManager& VLMAnalyzer::GetSearchManager() const
@@ -383,6 +1199,39 @@ const bool VLMAnalyzer::GetProofTreeOR(MoveTree * const proof_tree, const bool g
     }
   }
 
+  constexpr PositionState S = GetPlayerStone(P);
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+  bool is_proof_tree_generated = false;
+
+  const bool is_summarized = generate_full_tree == kGenerateSummarizedTree;
+  const auto memo_key = std::make_pair(hash_value, depth);
+  const auto memo_it = is_summarized ? summarized_or_memo_.find(memo_key) : summarized_or_memo_.end();
+
+  if(memo_it != summarized_or_memo_.end()){
+    // 集約済の局面: 登録済の詰む手のみ展開する
+    for(const auto move : memo_it->second){
+      const bool is_already_child = proof_tree->MoveChildNode(move);
+
+      if(is_already_child){
+        proof_tree->MoveParent();
+        continue;
+      }
+
+      proof_tree->AddChild(move);
+      proof_tree->MoveChildNode(move);
+      MakeMove(move);
+
+      const auto is_child_generated = GetProofTreeAND<Q>(proof_tree, generate_full_tree);
+
+      UndoMove();
+      proof_tree->MoveParent();
+
+      is_proof_tree_generated |= is_child_generated;
+    }
+
+    return is_proof_tree_generated;
+  }
+
   MoveList candidate_move;
   VLMSearch vlm_search;
   vlm_search.is_search = false;
@@ -390,9 +1239,7 @@ const bool VLMAnalyzer::GetProofTreeOR(MoveTree * const proof_tree, const bool g
 
   GetCandidateMoveOR<P>(vlm_search, &candidate_move);
 
-  constexpr PositionState S = GetPlayerStone(P);
-  constexpr PlayerTurn Q = GetOpponentTurn(P);
-  bool is_proof_tree_generated = false;
+  MoveList generated_move;    // 証明木に登録した詰む手
 
   // いずれかの候補手で詰みが登録されているかチェックする
   for(const auto move : candidate_move){
@@ -413,6 +1260,11 @@ const bool VLMAnalyzer::GetProofTreeOR(MoveTree * const proof_tree, const bool g
       continue;
     }
 
+    if(shortest_solution_ && GetVLMDepth(child_search_value) + 1 > depth){
+      // 最短手順モードでは最短の詰む手のみ登録する
+      continue;
+    }
+
     // move: 登録済の詰む手
     const bool is_already_child = proof_tree->MoveChildNode(move);
 
@@ -432,6 +1284,11 @@ const bool VLMAnalyzer::GetProofTreeOR(MoveTree * const proof_tree, const bool g
     proof_tree->MoveParent();
 
     is_proof_tree_generated |= is_child_generated;
+    generated_move += move;
+  }
+
+  if(is_summarized && is_proof_tree_generated){
+    summarized_or_memo_.insert(std::make_pair(memo_key, generated_move));
   }
 
   return is_proof_tree_generated;
@@ -442,6 +1299,45 @@ const bool VLMAnalyzer::GetProofTreeAND(MoveTree * const proof_tree, const bool
 {
   assert(proof_tree != nullptr);
 
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  const bool is_summarized = generate_full_tree == kGenerateSummarizedTree;
+  const auto hash_value = CalcHashValue(board_move_sequence_);
+
+  // 同一局面でも詰みの深さが異なる場合(証明木の取得中のSimulationで短い詰みが登録された場合等)は別の局面として集約する
+  VLMSearchValue and_search_value = 0;
+  const bool is_proved = is_summarized && vlm_table_->find(hash_value, bit_board_, &and_search_value) && IsVLMProved(and_search_value);
+  const auto memo_key = std::make_pair(hash_value, is_proved ? GetVLMDepth(and_search_value) : static_cast<VLMSearchDepth>(0));
+  const auto memo_it = is_summarized ? summarized_and_memo_.find(memo_key) : summarized_and_memo_.end();
+
+  if(memo_it != summarized_and_memo_.end()){
+    // 集約済の局面: Passの証明木の取得とSimulationを省略し、登録済の防手のみ展開する
+    for(const auto move : memo_it->second){
+      const bool is_already_child = proof_tree->MoveChildNode(move);
+
+      if(is_already_child){
+        // すでに証明木に登録済
+        proof_tree->MoveParent();
+        continue;
+      }
+
+      proof_tree->AddChild(move);
+      proof_tree->MoveChildNode(move);
+      MakeMove(move);
+
+      const auto is_child_generated = GetProofTreeOR<Q>(proof_tree, generate_full_tree);
+
+      UndoMove();
+      proof_tree->MoveParent();
+
+      if(!is_child_generated){
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   VLMSearch vlm_search;
   vlm_search.is_search = false;
   vlm_search.remain_depth = 225;
@@ -449,28 +1345,42 @@ const bool VLMAnalyzer::GetProofTreeAND(MoveTree * const proof_tree, const bool
   MoveList candidate_move;
   const auto is_terminate_guard = GetCandidateMoveAND<P>(vlm_search, &candidate_move);
 
-  constexpr PlayerTurn Q = GetOpponentTurn(P);
-
   // 集約した証明木を生成する場合はPassした際の詰む手順を求める
-  MoveTree threat_proof_tree;
+  MoveTree generated_threat_proof_tree;
+  MoveTree *threat_proof_tree = &generated_threat_proof_tree;
+  bool is_threat_proof_tree_generated = false;
 
-  if(generate_full_tree == kGenerateSummarizedTree && !is_terminate_guard){
+  if(is_summarized && !is_terminate_guard){
     MakeMove(kNullMove);
-    GetProofTreeOR<Q>(&threat_proof_tree, kGenerateSummarizedTree);
+
+    // Passした局面の証明木は手順前後で同一局面になる場合はメモを用いる
+    const auto pass_hash_value = CalcHashValue(board_move_sequence_);
+    auto threat_it = threat_proof_tree_memo_.find(pass_hash_value);
+
+    if(threat_it == threat_proof_tree_memo_.end()){
+      GetProofTreeOR<Q>(&generated_threat_proof_tree, kGenerateSummarizedTree);
+      threat_it = threat_proof_tree_memo_.insert(std::make_pair(pass_hash_value, std::move(generated_threat_proof_tree))).first;
+    }
+
+    threat_proof_tree = &(threat_it->second);
     UndoMove();
+
+    is_threat_proof_tree_generated = true;
   }
 
+  MoveList generated_move;    // 証明木に登録した防手
+
   // すべての候補手の詰みが登録されているかチェックする
   for(const auto move : candidate_move){
     // すべての候補手が登録済であることが期待されるのでBitBoardのみの更新ではなくMakeMove, Undoで更新する
     MakeMove(move);
 
     // 集約した証明木を生成する場合はPassした時の詰む手順と同手順詰む手は記録しない
-    if(generate_full_tree == kGenerateSummarizedTree && move != kNullMove && !threat_proof_tree.empty()){
+    if(is_summarized && move != kNullMove && !threat_proof_tree->empty()){
       VLMSearch vlm_simulation;
       vlm_simulation.is_search = false;
       
-      const auto or_node_value = SimulationOR<Q>(vlm_simulation, kScanProofTree, &threat_proof_tree);
+      const auto or_node_value = SimulationOR<Q>(vlm_simulation, kScanProofTree, threat_proof_tree);
       search_manager_.AddSimulationResult(IsVLMProved(or_node_value));
 
       if(IsVLMProved(or_node_value)){
@@ -482,9 +1392,32 @@ const bool VLMAnalyzer::GetProofTreeAND(MoveTree * const proof_tree, const bool
     const auto child_hash_value = CalcHashValue(board_move_sequence_); // AND nodeはPassがあるため逐次計算する
 
     VLMSearchValue search_value;
-    const auto is_find = vlm_table_->find(child_hash_value, bit_board_, &search_value);
+    auto is_find = vlm_table_->find(child_hash_value, bit_board_, &search_value);
     bool is_child_generated = false;
 
+    if(!(is_find && IsVLMProved(search_value)) && move != kNullMove && !is_terminate_guard){
+      // 影響領域外のため枝刈りした防手はPassの証明木によるSimulationで置換表に登録する
+      if(!is_threat_proof_tree_generated){
+        UndoMove();
+        MakeMove(kNullMove);
+        GetProofTreeOR<Q>(threat_proof_tree, generate_full_tree);
+        UndoMove();
+        MakeMove(move);
+
+        is_threat_proof_tree_generated = true;
+      }
+
+      if(!threat_proof_tree->empty()){
+        VLMSearch vlm_simulation;
+        vlm_simulation.is_search = false;
+
+        const auto or_node_value = SimulationOR<Q>(vlm_simulation, kCheckVLMTable, threat_proof_tree);
+        search_manager_.AddSimulationResult(IsVLMProved(or_node_value));
+
+        is_find = vlm_table_->find(child_hash_value, bit_board_, &search_value);
+      }
+    }
+
     if(is_find && IsVLMProved(search_value)){
       proof_tree->AddChild(move);
       proof_tree->MoveChildNode(move);
@@ -492,6 +1425,7 @@ const bool VLMAnalyzer::GetProofTreeAND(MoveTree * const proof_tree, const bool
       is_child_generated = GetProofTreeOR<Q>(proof_tree, generate_full_tree);
   
       proof_tree->MoveParent();
+      generated_move += move;
     }
 
     UndoMove();
@@ -502,6 +1436,220 @@ const bool VLMAnalyzer::GetProofTreeAND(MoveTree * const proof_tree, const bool
     }
   }
 
+  if(is_summarized){
+    summarized_and_memo_.insert(std::make_pair(memo_key, generated_move));
+  }
+
+  return true;
+}
+
+template<PlayerTurn P>
+const bool VLMAnalyzer::GetDisproofCertificateOR(std::string * const certificate)
+{
+  assert(certificate != nullptr);
+
+  if(++disproof_certificate_node_ > kDisproofCertificateNodeLimit){
+    return false;
+  }
+
+  MovePosition terminating_move;
+
+  if(TerminateCheck(&terminating_move)){
+    // 攻め側の勝ち
+    return false;
+  }
+
+  VLMSearch vlm_search;
+  vlm_search.is_search = false;
+  vlm_search.remain_depth = 225;
+
+  MoveList candidate_move;
+  GetCandidateMoveOR<P>(vlm_search, &candidate_move);
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  // すべての候補手に対して強意の不詰となる防手以下の証明書を生成する
+  std::vector<std::string> and_certificate(candidate_move.size());
+  std::map<std::string, size_t> certificate_count;
+
+  for(size_t i=0, size=candidate_move.size(); i<size; i++){
+    MakeMove(candidate_move[i]);
+    const bool is_generated = GetDisproofCertificateAND<Q>(&and_certificate[i]);
+    UndoMove();
+
+    if(!is_generated){
+      return false;
+    }
+
+    certificate_count[and_certificate[i]]++;
+  }
+
+  // 最も多くの候補手に共通する証明書を既定とし、既定と異なる候補手(詰みを防ぐ手順に関係する手)のみ記録する
+  const std::string *default_certificate = nullptr;
+  size_t default_count = 0;
+
+  for(const auto &count : certificate_count){
+    if(count.second > default_count){
+      default_certificate = &count.first;
+      default_count = count.second;
+    }
+  }
+
+  const size_t exception_count = candidate_move.size() - default_count;
+  assert(exception_count <= kInBoardMoveNum);
+  *certificate += static_cast<char>(exception_count);
+
+  for(size_t i=0, size=candidate_move.size(); i<size; i++){
+    if(and_certificate[i] != *default_certificate){
+      *certificate += static_cast<char>(candidate_move[i]);
+      *certificate += and_certificate[i];
+    }
+  }
+
+  if(default_count == 0){
+    *certificate += static_cast<char>(kDisproofNoDefaultTag);
+  }else{
+    *certificate += static_cast<char>(kDisproofDefaultTag);
+    *certificate += *default_certificate;
+  }
+
+  return true;
+}
+
+template<PlayerTurn P>
+const bool VLMAnalyzer::GetDisproofCertificateAND(std::string * const certificate)
+{
+  assert(certificate != nullptr);
+
+  // 手順前後で合流する局面は取得済の証明書を用いる
+  const auto and_hash_value = CalcHashValue(board_move_sequence_);
+  const auto find_it = disproof_and_memo_.find(and_hash_value);
+
+  if(find_it != disproof_and_memo_.end()){
+    *certificate += find_it->second;
+    return !find_it->second.empty();
+  }
+
+  if(++disproof_certificate_node_ > kDisproofCertificateNodeLimit){
+    return false;
+  }
+
+  std::string and_certificate;
+  MovePosition terminating_move;
+
+  if(TerminateCheck(&terminating_move)){
+    // 防御側の勝ち
+    and_certificate += static_cast<char>(kDisproofTerminalTag);
+  }else{
+    VLMSearch vlm_search;
+    vlm_search.is_search = false;
+    vlm_search.remain_depth = 225;
+
+    MoveList candidate_move;
+    GetCandidateMoveAND<P>(vlm_search, &candidate_move);
+
+    constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+    // 強意の不詰が登録されている防手を探す
+    for(const auto move : candidate_move){
+      MakeMove(move);
+
+      const auto hash_value = CalcHashValue(board_move_sequence_);
+      VLMSearchValue search_value = 0;
+      const bool is_disproved = vlm_table_->find(hash_value, bit_board_, &search_value) && IsVLMDisproved(search_value);
+      bool is_generated = false;
+
+      if(is_disproved){
+        and_certificate += static_cast<char>(kDisproofGuardTag);
+        and_certificate += static_cast<char>(move);
+
+        is_generated = GetDisproofCertificateOR<Q>(&and_certificate);
+
+        if(!is_generated){
+          // 他の防手を試すため記録を取り消す
+          and_certificate.clear();
+        }
+      }
+
+      UndoMove();
+
+      if(is_generated){
+        break;
+      }
+    }
+  }
+
+  // 取得できなかった場合は空の証明書を記録する(取得できた証明書はタグを含むため空にならない)
+  disproof_and_memo_[and_hash_value] = and_certificate;
+  *certificate += and_certificate;
+
+  return !and_certificate.empty();
+}
+
+template<PlayerTurn P>
+const bool VLMAnalyzer::GetRecordedProofTreeOR(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  MovePosition terminating_move;
+
+  if(TerminateCheck(&terminating_move)){
+    // 終端
+    proof_tree->AddChild(terminating_move);
+    return true;
+  }
+
+  const auto hash_value = CalcHashValue(board_move_sequence_);
+  const auto find_it = or_proof_record_.find(hash_value);
+
+  if(find_it == or_proof_record_.end()){
+    return false;
+  }
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+  const auto move = find_it->second.second;
+
+  proof_tree->AddChild(move);
+  proof_tree->MoveChildNode(move);
+  MakeMove(move);
+
+  const bool is_generated = GetRecordedProofTreeAND<Q>(proof_tree);
+
+  UndoMove();
+  proof_tree->MoveParent();
+
+  return is_generated;
+}
+
+template<PlayerTurn P>
+const bool VLMAnalyzer::GetRecordedProofTreeAND(MoveTree * const proof_tree)
+{
+  assert(proof_tree != nullptr);
+
+  const auto hash_value = CalcHashValue(board_move_sequence_);
+  const auto find_it = and_proof_record_.find(hash_value);
+
+  if(find_it == and_proof_record_.end()){
+    return false;
+  }
+
+  constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+  for(const auto move : find_it->second.second){
+    proof_tree->AddChild(move);
+    proof_tree->MoveChildNode(move);
+    MakeMove(move);
+
+    const bool is_child_generated = GetRecordedProofTreeOR<Q>(proof_tree);
+
+    UndoMove();
+    proof_tree->MoveParent();
+
+    if(!is_child_generated){
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -512,14 +1660,14 @@ VLMSearchValue VLMAnalyzer::SimulationOR(const VLMSearch &vlm_search, const bool
 
   search_manager_.AddNode();
 
-  if(search_manager_.IsTerminate()){
+  if(IsSearchTerminate()){
     return kVLMWeakDisprovedUB;
   }
 
   // 置換表をチェック
   const auto hash_value = CalcHashValue(board_move_sequence_);
   VLMSearchValue table_value = 0;
-  bool is_registered = check_vlm_table ? vlm_table_->find(hash_value, bit_board_, &table_value) : false;
+  bool is_registered = check_vlm_table ? FindSearchValue(vlm_search, hash_value, &table_value) : false;
 
   if(is_registered){
     if(IsVLMProved(table_value) || IsVLMDisproved(table_value)){
@@ -564,6 +1712,7 @@ VLMSearchValue VLMAnalyzer::SimulationOR(const VLMSearch &vlm_search, const bool
   child_vlm_search.remain_depth--;
   constexpr PlayerTurn Q = GetOpponentTurn(P);
   VLMSearchValue or_node_value = kVLMWeakDisprovedLB;   // 展開する手を証明木の手に制限するので詰まなくても弱意の不詰
+  MovePosition proof_move = kNullMove;    // 最短で詰む手
 
   for(const auto move : candidate_move){
     // 証明木に存在する手のみ展開する
@@ -576,6 +1725,10 @@ VLMSearchValue VLMAnalyzer::SimulationOR(const VLMSearch &vlm_search, const bool
     UndoMove();
     proof_tree->MoveParent();
 
+    if(IsVLMProved(and_node_value) && and_node_value > or_node_value){
+      proof_move = move;
+    }
+
     or_node_value = std::max(or_node_value, and_node_value);
     
     if(!vlm_search.detect_dual_solution && IsVLMProved(and_node_value)){
@@ -588,6 +1741,7 @@ VLMSearchValue VLMAnalyzer::SimulationOR(const VLMSearch &vlm_search, const bool
   if(IsVLMProved(search_value)){
     // Simulaitonでは確定値のみ登録する
     vlm_table_->Upsert(hash_value, bit_board_, search_value);
+    RecordProofOR(vlm_search, hash_value, search_value, proof_move);
   }
 
   return search_value;
@@ -600,14 +1754,14 @@ VLMSearchValue VLMAnalyzer::SimulationAND(const VLMSearch &vlm_search, const boo
 
   search_manager_.AddNode();
 
-  if(search_manager_.IsTerminate()){
+  if(IsSearchTerminate()){
     return kVLMWeakDisprovedUB;
   }
 
   // 置換表をチェック
   const auto hash_value = CalcHashValue(board_move_sequence_);
   VLMSearchValue table_value = 0;
-  const bool is_registered = check_vlm_table ? vlm_table_->find(hash_value, bit_board_, &table_value) : false;
+  const bool is_registered = check_vlm_table ? FindSearchValue(vlm_search, hash_value, &table_value) : false;
 
   if(is_registered){
     if(IsVLMProved(table_value) || IsVLMDisproved(table_value)){
@@ -688,6 +1842,7 @@ VLMSearchValue VLMAnalyzer::SimulationAND(const VLMSearch &vlm_search, const boo
   if(IsVLMProved(search_value)){
     // Simulationでは確定値のみ登録する
     vlm_table_->Upsert(hash_value, bit_board_, search_value);
+    RecordProofAND(vlm_search, hash_value, search_value, candidate_move);
   }
 
   return search_value;
@@ -711,7 +1866,7 @@ const bool VLMAnalyzer::DetectDualSolutionOR(MoveTree * const proof_tree, MoveLi
   const auto depth = GetVLMDepth(search_value);
 
   constexpr PlayerTurn Q = GetOpponentTurn(P);
-  std::map<MovePosition, MoveTree> move_proof_tree;   // 詰む手と証明木のmap
+  std::map<MovePosition, VLMProvedMoveTree> move_proof_tree;   // 詰む手と証明木のmap
   bool detect_dual_solution = false;    // 余詰フラグ
 
   // 証明木中の詰む手が複数ある場合に余詰になっていないかチェックする
@@ -725,9 +1880,19 @@ const bool VLMAnalyzer::DetectDualSolutionOR(MoveTree * const proof_tree, MoveLi
     return false;
   }
 
+  // 詰む手の証明木は互いに独立しているため並行して取得する
+  std::map<MovePosition, VLMProvedMoveTree> generated_tree;
+
+  if(proved_move_list.size() >= 2 && dual_solution_thread_ >= 2){
+    GetProvedMoveTreeParallel<P>(proved_move_list, &generated_tree);
+  }
+
   for(const auto move : proved_move_list){
     if(proved_move_list.size() >= 2){
-      UpdateDualSolution<P>(move, &move_proof_tree);
+      const auto generated_it = generated_tree.find(move);
+      const VLMProvedMoveTree * const proved_move_tree = generated_it == generated_tree.end() ? nullptr : &generated_it->second;
+
+      UpdateDualSolution<P>(move, proved_move_tree, &move_proof_tree);
     }
 
     if(move_proof_tree.size() >= 2){
@@ -762,7 +1927,7 @@ const bool VLMAnalyzer::DetectDualSolutionOR(MoveTree * const proof_tree, MoveLi
 }
 
 template<PlayerTurn P>
-void VLMAnalyzer::UpdateDualSolution(const MovePosition move, std::map<MovePosition, MoveTree> * const move_proof_tree)
+void VLMAnalyzer::UpdateDualSolution(const MovePosition move, const VLMProvedMoveTree * const generated_tree, std::map<MovePosition, VLMProvedMoveTree> * const move_proof_tree)
 {
   assert(move_proof_tree != nullptr);
 
@@ -792,45 +1957,83 @@ void VLMAnalyzer::UpdateDualSolution(const MovePosition move, std::map<MovePosit
 
   // moveの証明木を取得する
   assert(move_proof_tree->find(move) == move_proof_tree->end());
-  MoveTree proof_tree;
+  VLMProvedMoveTree proved_move_tree;
+
+  if(generated_tree != nullptr){
+    proved_move_tree = *generated_tree;
+  }else{
+    GetProvedMoveTree<P>(move, &proved_move_tree);
+  }
+
+  if(!proved_move_tree.is_generated){
+    return;
+  }
+
+  // 手順前後(終端局面1手前の局面集合が同一)のチェック: 登録済の証明木のHash値集合は登録時に求めたものを用いる
+  for(const auto &move_tree : *move_proof_tree){
+    if(proved_move_tree.pre_terminate_hash == move_tree.second.pre_terminate_hash){
+      return;
+    }
+  }
 
+  move_proof_tree->insert(std::make_pair(move, std::move(proved_move_tree)));
+}
+
+template<PlayerTurn P>
+void VLMAnalyzer::GetProvedMoveTree(const MovePosition move, VLMProvedMoveTree * const proved_move_tree)
+{
+  assert(proved_move_tree != nullptr);
+
+  MoveTree &proof_tree = proved_move_tree->proof_tree;
   proof_tree.AddChild(move);
   proof_tree.MoveChildNode(move);
 
   constexpr PlayerTurn Q = GetOpponentTurn(P);
 
+  ClearSummarizedProofTreeMemo();
+
   MakeMove(move);
-  const bool generate_proof_tree = GetProofTreeAND<Q>(&proof_tree, kGenerateSummarizedTree);
+  proved_move_tree->is_generated = GetProofTreeAND<Q>(&proof_tree, kGenerateSummarizedTree);
   UndoMove();
 
-  if(!generate_proof_tree){
-    assert(!generate_proof_tree);
-    return;
+  ClearSummarizedProofTreeMemo();
+
+  if(proved_move_tree->is_generated){
+    GetPreTerminateHash(&proof_tree, &proved_move_tree->pre_terminate_hash);
   }
+}
 
-  // 手順前後(終端局面1手前の局面集合が同一)のチェック
-  if(!move_proof_tree->empty()){
-    std::set<HashValue> check_hash_set;      // 終端局面1手前の局面のHash値
-    GetPreTerminateHash(&proof_tree, &check_hash_set);
-    bool synonymous_solution = false;
+template<PlayerTurn P>
+void VLMAnalyzer::GetProvedMoveTreeParallel(const MoveList &proved_move_list, std::map<MovePosition, VLMProvedMoveTree> * const proved_move_tree)
+{
+  assert(proved_move_tree != nullptr);
 
-    for(auto &move_tree : *move_proof_tree){
-      std::set<HashValue> registered_hash_set;
-      auto &registered_proof_tree = move_tree.second;
-      GetPreTerminateHash(&registered_proof_tree, &registered_hash_set);
+  const size_t move_count = proved_move_list.size();
+  const size_t thread_num = std::min(dual_solution_thread_, move_count);
+  std::vector<VLMProvedMoveTree> proved_move_tree_list(move_count);
+  std::atomic<size_t> next_index(0);
 
-      if(check_hash_set == registered_hash_set){
-        synonymous_solution = true;
-        break;
-      }
-    }
+  boost::thread_group thread_group;
 
-    if(synonymous_solution){
-      return;
-    }
+  for(size_t i=0; i<thread_num; i++){
+    thread_group.create_thread([this, &proved_move_list, &proved_move_tree_list, &next_index, move_count](){
+      // 現局面の複製(VCF探索用置換表はロック制御の有無によらず並行して使用できるようthreadごとに確保する)
+      VLMAnalyzer vlm_analyzer(board_move_sequence_, vlm_table_);
+
+      // 証明木の取得方法は逐次取得と同じ設定とする
+      vlm_analyzer.shortest_solution_ = shortest_solution_;
+
+      for(size_t index=next_index++; index<move_count; index=next_index++){
+        vlm_analyzer.GetProvedMoveTree<P>(proved_move_list[index], &proved_move_tree_list[index]);
+      }
+    });
   }
 
-  move_proof_tree->insert(std::make_pair(move, proof_tree));
+  thread_group.join_all();
+
+  for(size_t i=0; i<move_count; i++){
+    proved_move_tree->insert(std::make_pair(proved_move_list[i], std::move(proved_move_tree_list[i])));
+  }
 }
 
 template<PlayerTurn P>
@@ -915,6 +2118,144 @@ inline const VLMSearchValue VLMAnalyzer::GetSearchValue(const VLMSearchValue chi
   return child_search_value - 1;
 }
 
+inline const bool VLMAnalyzer::IsSimulationEffective(const VLMSearchDepth remain_depth, const size_t proof_tree_depth, std::uint64_t * const skip_count)
+{
+  assert(skip_count != nullptr);
+
+  const size_t remain_index = std::min(static_cast<size_t>(remain_depth), kSimulationStatDepthNum - 1);
+  const size_t proof_tree_index = std::min(proof_tree_depth, kSimulationStatDepthNum - 1);
+
+  auto &simulation_stat = simulation_stat_[remain_index][proof_tree_index];
+  const auto &solve_stat = solve_stat_[remain_index];
+
+  if(simulation_stat.simulation_count < kSimulationSampleCount || solve_stat.solve_count == 0){
+    // 実績が不足している場合はSimulationを行う
+    return true;
+  }
+
+  // 成功率 x 通常探索の平均ノード数 >= Simulationの平均ノード数 であれば効果あり(両辺にSimulation回数を掛けて比較する)
+  const double expected_saving_node = static_cast<double>(simulation_stat.success_count) * solve_stat.solve_node / solve_stat.solve_count;
+
+  if(expected_saving_node >= static_cast<double>(simulation_stat.simulation_node)){
+    return true;
+  }
+
+  // 効果のない区分でも実績を更新するため一定間隔で試行する
+  simulation_stat.ineffective_count++;
+
+  if(simulation_stat.ineffective_count % kSimulationProbeInterval == 0){
+    return true;
+  }
+
+  (*skip_count)++;
+  return false;
+}
+
+inline void VLMAnalyzer::UpdateSimulationStat(const VLMSearchDepth remain_depth, const size_t proof_tree_depth, const bool is_success, const std::uint64_t node)
+{
+  const size_t remain_index = std::min(static_cast<size_t>(remain_depth), kSimulationStatDepthNum - 1);
+  const size_t proof_tree_index = std::min(proof_tree_depth, kSimulationStatDepthNum - 1);
+
+  auto &simulation_stat = simulation_stat_[remain_index][proof_tree_index];
+
+  simulation_stat.simulation_count++;
+  simulation_stat.success_count += is_success ? 1 : 0;
+  simulation_stat.simulation_node += node;
+}
+
+inline void VLMAnalyzer::UpdateSolveStat(const VLMSearchDepth remain_depth, const std::uint64_t node)
+{
+  const size_t remain_index = std::min(static_cast<size_t>(remain_depth), kSimulationStatDepthNum - 1);
+  auto &solve_stat = solve_stat_[remain_index];
+
+  solve_stat.solve_count++;
+  solve_stat.solve_node += node;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetSimulationSkipCount() const
+{
+  return simulation_skip_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetProofTreeSkipCount() const
+{
+  return proof_tree_skip_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetRelevanceZonePruneCount() const
+{
+  return relevance_zone_prune_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetDepthTwoProbeCount() const
+{
+  return depth_two_probe_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetDepthTwoMoveCount() const
+{
+  return depth_two_move_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetRefutationCount() const
+{
+  return refutation_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetRefutationNode() const
+{
+  return refutation_node_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetRefutationMoveCount() const
+{
+  return refutation_move_count_;
+}
+
+inline const std::uint64_t VLMAnalyzer::GetDualSolutionTime() const
+{
+  return dual_solution_time_;
+}
+
+inline const bool VLMAnalyzer::IsSearchInterrupted()
+{
+  return search_manager_.IsTerminate() || is_budget_exhausted_;
+}
+
+inline const bool VLMAnalyzer::IsSearchTerminate()
+{
+  if(search_manager_.IsTerminate() || is_budget_exhausted_){
+    return true;
+  }
+
+  if(yield_node_interval_ != 0 && search_manager_.GetNode() >= next_yield_node_){
+    // 探索を中断する(再開時は中断時の局面から探索を継続する)
+    next_yield_node_ = search_manager_.GetNode() + yield_node_interval_;
+    yield_callback_();
+  }
+
+  if(progress_node_interval_ != 0 && search_manager_.GetNode() >= next_progress_node_){
+    next_progress_node_ = search_manager_.GetNode() + progress_node_interval_;
+
+    if(progress_result_ != nullptr){
+      const auto &root_move_order = progress_result_->root_move_order;
+      NotifyProgress(false, progress_depth_, root_move_order.empty() ? kNullMove : root_move_order[0]);
+    }
+  }
+
+  if(budget_node_limit_ != 0 && search_manager_.GetNode() >= budget_node_limit_){
+    is_budget_exhausted_ = true;
+    return true;
+  }
+
+  if(is_time_limited_ && ++budget_check_count_ % kBudgetCheckInterval == 0 && std::chrono::steady_clock::now() >= budget_deadline_){
+    is_budget_exhausted_ = true;
+    return true;
+  }
+
+  return false;
+}
+
 inline const bool VLMAnalyzer::IsRootNode() const
 {
   return search_sequence_.empty();
@@ -8,11 +8,18 @@
 #include <cstdint>
 #include <climits>
 #include <memory>
+#include <array>
+#include <map>
+#include <set>
+#include <chrono>
+#include <functional>
+#include <string>
 
 #include "MoveTree.h"
 #include "Board.h"
 #include "SearchManager.h"
 #include "VLMTranspositionTable.h"
+#include "VLMMoveOrderingTable.h"
 
 namespace realcore
 {
@@ -48,20 +55,70 @@ constexpr VLMSearchValue GetVLMWeakDisprovedSearchValue(const VLMSearchDepth dep
 typedef struct sturctVLMSearch
 {
   sturctVLMSearch()
-  : is_search(true), detect_dual_solution(true), remain_depth(kInBoardMoveNum)
+  : is_search(true), detect_dual_solution(true), remain_depth(kInBoardMoveNum), adaptive_simulation(true),
+    relevance_zone_pruning(true), vcf_precheck(true), shallow_solver(true), node_limit(0), time_limit(0),
+    dual_solution_thread(1), record_proof_tree(false), shortest_solution(false), disproof_certificate(false),
+    forced_move_extension(true), threat_move_ordering(false), train_move_ordering(false)
   {
   }
 
   bool is_search;                 //!< 探索(true), 証明木取得, Simulaiton(false): MoveOrdering制御に使用
   bool detect_dual_solution;      //!< 余詰探索をするかどうかのフラグ
   VLMSearchDepth remain_depth;    //!< 探索残り深さ
+  bool adaptive_simulation;       //!< Simulationの成功実績から効果のない区分のSimulation, 証明木取得を省略するかのフラグ
+  bool relevance_zone_pruning;    //!< AND nodeでPassの証明木の影響領域外の防手を枝刈りするかのフラグ
+  bool vcf_precheck;              //!< OR nodeでVCF(四ノビ連続の勝ち)を事前にチェックするかのフラグ
+  bool shallow_solver;            //!< 残り深さ3のOR node, 残り深さ2のAND nodeを専用ルーチンで探索するかのフラグ
+  std::uint64_t node_limit;       //!< 探索ノード数の上限(0: 上限なし)
+  std::uint64_t time_limit;       //!< 探索時間の上限[ms](0: 上限なし)
+  size_t dual_solution_thread;    //!< 余詰判定で詰む手の証明木を並行して取得するthread数(2以上は置換表のロック制御が必要)
+  bool record_proof_tree;         //!< 探索中に詰む手, 防手を記録し、記録から証明木を取得するかのフラグ
+  bool shortest_solution;         //!< 各局面で最短の詰みのみを採用し、最短手順であることを保証するかのフラグ
+  bool disproof_certificate;      //!< 強意の不詰の場合に不詰の証明書を取得するかのフラグ
+  bool forced_move_extension;     //!< 四に対する防手が1手に限られるAND nodeをOR nodeから続けて展開するかのフラグ
+  bool threat_move_ordering;      //!< AND nodeの防手を攻め側の脅威の推定値で順序付けするかのフラグ(false: 三を作る手, 相手の四ノビ点の順)
+  bool train_move_ordering;       //!< 詰む手, 詰みを防ぐ手の順序付けの区分の実績を集計するかのフラグ
 }VLMSearch;
 
+//! @brief Simulationの実績
+typedef struct structVLMSimulationStat
+{
+  structVLMSimulationStat()
+  : simulation_count(0), success_count(0), simulation_node(0), ineffective_count(0)
+  {
+  }
+
+  std::uint64_t simulation_count;   //!< Simulation回数
+  std::uint64_t success_count;      //!< Simulation成功回数
+  std::uint64_t simulation_node;    //!< Simulationの探索ノード数
+  std::uint64_t ineffective_count;  //!< 効果がないと判定した回数(一定間隔で試行するため)
+}VLMSimulationStat;
+
+//! @brief 指し手の順序付けの区分に該当する指し手(区分ごとに必要になった時点で列挙する)
+typedef struct structVLMMoveOrderingBit
+{
+  std::array<MoveBitSet, kMoveOrderingCategoryNum> category_bit;    //!< 区分 -> 該当する指し手
+  std::array<bool, kMoveOrderingCategoryNum> is_enumerated{};        //!< 区分 -> 列挙済か
+}VLMMoveOrderingBit;
+
+//! @brief 通常探索の実績
+typedef struct structVLMSolveStat
+{
+  structVLMSolveStat()
+  : solve_count(0), solve_node(0)
+  {
+  }
+
+  std::uint64_t solve_count;    //!< 通常探索回数
+  std::uint64_t solve_node;     //!< 通常探索の探索ノード数
+}VLMSolveStat;
+
 //! @brief 解図結果
 typedef struct structVLMResult
 {
   structVLMResult()
-  : solved(false), disproved(false), search_depth(0), detect_dual_solution(false)
+  : solved(false), disproved(false), search_depth(0), detect_dual_solution(false), budget_exhausted(false),
+    shortest_solution(false), result_cached(false)
   {
   }
 
@@ -72,24 +129,102 @@ typedef struct structVLMResult
   bool detect_dual_solution;       // 余詰の有無
   MoveTree dual_solution_tree;     // 余詰の変化
   MoveList best_response;          // 最善応手
+  bool budget_exhausted;           // 探索ノード数 or 探索時間の上限に達したか(search_depthは完了した深さ)
+  bool shortest_solution;          // 証明木が最短手順であることを証明済か(VLMSearch::shortest_solution指定時のみ)
+  std::string disproof_certificate;   // 不詰の証明書(VLMSearch::disproof_certificate指定時のみ, 取得できない場合は空)
+  bool result_cached;              // 解図結果キャッシュから取得したか(探索していない)
+
+  // 反復深化の継続用の情報
+  MoveList root_move_order;        // 次の反復でroot nodeの候補手を展開する順序(有望な順)
+  MoveBitSet refuted_root_move;    // 強意の不詰が確定したroot nodeの候補手
+  std::map<MovePosition, MovePosition> best_defense;    // root nodeの候補手 -> 詰みを防いだ防手
 }VLMResult;
 
+//! @brief 余詰判定用の詰む手の証明木
+typedef struct structVLMProvedMoveTree
+{
+  structVLMProvedMoveTree()
+  : is_generated(false)
+  {
+  }
+
+  bool is_generated;                          // 証明木を取得できたか
+  MoveTree proof_tree;                        // 詰む手をroot nodeの子とする集約した証明木
+  std::set<HashValue> pre_terminate_hash;     // 終端局面1手前の局面のHash値(手順前後の判定用)
+}VLMProvedMoveTree;
+
+//! @brief 探索の進捗
+typedef struct structVLMProgress
+{
+  structVLMProgress()
+  : is_iteration_end(false), search_depth(0), node(0), search_time(0), nps(0), table_fill_rate(0), best_move(kNullMove)
+  {
+  }
+
+  bool is_iteration_end;           // 反復深化の深さの探索終了時の通知か
+  VLMSearchDepth search_depth;     // 探索中の深さ(is_iteration_end: 探索を終えた深さ)
+  std::uint64_t node;              // 探索ノード数
+  std::uint64_t search_time;       // 探索時間[ms]
+  double nps;                      // 探索速度
+  double table_fill_rate;          // 置換表の使用率
+  MovePosition best_move;          // root nodeの最善手(詰む手 or 前回の反復で最も有望な手, 未定: kNullMove)
+}VLMProgress;
+
+//! @brief 探索の進捗の通知先
+typedef std::function<void(const VLMProgress&)> VLMProgressCallback;
+
+//! @brief 探索の進捗をJSON形式の文字列(1行)で返す
+//! @param problem_id 問題ID(空文字列の場合は出力しない)
+const std::string GetVLMProgressJSON(const VLMProgress &progress, const std::string &problem_id);
+
+//! @brief JSONの文字列値としてエスケープする
+const std::string EscapeJSONString(const std::string &str);
+
 // 前方宣言
 class VLMAnalyzerTest;
+class VLMProofVerifier;
 
 class VLMAnalyzer
 : public Board
 {
   friend class VLMAnalyzerTest;
+  friend class VLMProofVerifier;
 
 public:
   //! @pre 対象局面の指し手リストは終端ではない正規手順であること
   VLMAnalyzer(const MoveList &board_move_sequence);
+
+  //! @param table_lock_control 確保する置換表, VCF探索用置換表のロック制御を行うか(余詰判定を並行して行う場合はkLockControl)
+  VLMAnalyzer(const MoveList &board_move_sequence, const bool table_lock_control);
+
+  //! @note VCF探索用置換表は最小サイズで確保する(複数局面を解図する場合はVCF探索用置換表を指定する)
   VLMAnalyzer(const MoveList &board_move_sequence, const std::shared_ptr<VLMTable> &vlm_table);
+  VLMAnalyzer(const MoveList &board_move_sequence, const std::shared_ptr<VLMTable> &vlm_table, const std::shared_ptr<VCFTable> &vcf_table);
 
   //! @brief 解図を行う
+  //! @note vlm_resultは初期化して解図する(前回の解図結果は引き継がない)
   void Solve(const VLMSearch &vlm_search, VLMResult * const vlm_result);
 
+  //! @brief 探索済の解図結果から反復深化を継続する
+  //! @param vlm_search 探索設定(remain_depthまで深化する)
+  //! @param vlm_result 同一局面のSolve, ResumeSolveの解図結果
+  //! @note 前回の反復のroot nodeの候補手の順序, 反証済の候補手, 最善の防手を引き継ぐ
+  void ResumeSolve(const VLMSearch &vlm_search, VLMResult * const vlm_result);
+
+  //! @brief 探索の進捗の通知先を設定する
+  //! @param progress_callback 通知先(反復深化の各深さの終了時, node_intervalノードごとに呼び出す)
+  //! @param node_interval 通知するノード数の間隔(0: 各深さの終了時のみ通知する)
+  void SetProgressCallback(const VLMProgressCallback &progress_callback, const std::uint64_t node_interval);
+
+  //! @brief 探索を中断する関数を設定する
+  //! @param yield_callback 探索中にnode_intervalノードごとに呼び出す(呼び出し中は探索が中断する)
+  //! @param node_interval 呼び出すノード数の間隔(0: 呼び出さない)
+  //! @see VLMSlicedSolver
+  void SetYieldCallback(const std::function<void()> &yield_callback, const std::uint64_t node_interval);
+
+  //! @brief 探索を中断するノード数の間隔を変更する(現在のノード数から数える)
+  void SetYieldInterval(const std::uint64_t node_interval);
+
   //! @brief 指し手を設定する
   void MakeMove(const MovePosition move);
   void MakeMove(const VLMSearch &child_vlm_search, const MovePosition move);
@@ -104,13 +239,64 @@ public:
   //! @note AND nodeでPassして詰む手順と同一手順で詰む手はPassに集約する
   const bool GetSummarizedProofTree(MoveTree * const proof_tree);
 
+  //! @brief 探索中に記録した詰む手, 防手から現局面をroot nodeとする証明木を取得する
+  //! @note VLMSearch::record_proof_treeを指定した探索後のみ取得できる。置換表の登録状況に依存しない
+  //! @note 影響領域外のため枝刈りした防手はPassと同一手順で詰むため証明木に含めない
+  const bool GetRecordedProofTree(MoveTree * const proof_tree);
+
+  //! @brief 置換表から現局面の強意の不詰の証明書(バイナリ形式)を取得する
+  //! @note OR nodeの全候補手に対して強意の不詰となる防手を再帰的に求め、最も多くの候補手に共通する防手以下の証明書を既定として1度だけ記録する
+  //! @note 既定と異なる候補手(詰みを防ぐ手順に関係する手)のみ指し手と防手を記録するため、空点ごとには記録しない
+  //! @note 手順前後で合流するAND nodeは1度だけ生成し、展開する局面数がkDisproofCertificateNodeLimitを超えた場合は取得しない
+  //! @retval false 強意の不詰ではない or 置換表から証明書を構成できない or 局面数の上限を超えた
+  //! @see VLMProofVerifier::VerifyDisproofCertificate
+  const bool GetDisproofCertificate(std::string * const certificate);
+
   //! @brief 探索制御オブジェクトを返す
   const SearchManager& GetSearchManager() const;
 
   //! @brief パラメタ設定情報を返す
   const std::string GetSettingInfo() const;
 
+  //! @brief 実績により省略したSimulationの回数を返す
+  const std::uint64_t GetSimulationSkipCount() const;
+
+  //! @brief 実績により省略した証明木取得の回数を返す
+  const std::uint64_t GetProofTreeSkipCount() const;
+
+  //! @brief 影響領域外のため枝刈りした防手の数を返す
+  const std::uint64_t GetRelevanceZonePruneCount() const;
+
+  //! @brief 残り深さ2のAND nodeで指し手を設定せずに評価した防手の数を返す
+  const std::uint64_t GetDepthTwoProbeCount() const;
+
+  //! @brief 残り深さ2のAND nodeで指し手を設定して終端チェックを行った防手の数を返す
+  const std::uint64_t GetDepthTwoMoveCount() const;
+
+  //! @brief 指し手の順序付けの区分ごとの実績を返す(VLMSearch::train_move_ordering指定時のみ集計する)
+  const MoveOrderingStatTable& GetMoveOrderingStat(const MoveOrderingNode node) const;
+
+  //! @brief 詰みを防ぐ防手が見つかったAND nodeの数を返す
+  const std::uint64_t GetRefutationCount() const;
+
+  //! @brief 詰みを防ぐ防手が見つかるまでの探索ノード数(AND nodeの合計)を返す
+  const std::uint64_t GetRefutationNode() const;
+
+  //! @brief 詰みを防ぐ防手が見つかるまでに展開した防手の数(AND nodeの合計, 詰みを防いだ防手を含む)を返す
+  const std::uint64_t GetRefutationMoveCount() const;
+
+  //! @brief 余詰判定の時間[ms]を返す
+  const std::uint64_t GetDualSolutionTime() const;
+
 private:
+  //! @brief 現局面の禁手を取得する
+  //! @note 探索手順の手数ごとにEnumerateForbiddenMovesの結果をキャッシュし、同一局面のOR node, AND nodeで再計算しない
+  void GetForbiddenMoveBit(MoveBitSet * const forbidden_bit) const;
+
+  //! @brief 指し手を設定した手数の禁手のキャッシュを更新する
+  //! @note Passは石の配置が変わらないため直前の局面の禁手を引き継ぐ
+  void UpdateForbiddenMoveCache(const MovePosition move);
+
   //! @brief 余詰判定を行う
   //! @param proof_tree 証明木
   //! @param best_response 最善応手
@@ -129,23 +315,99 @@ private:
 
   //! @brief 余詰となる手を管理する
   //! @param move 詰む手
+  //! @param generated_tree 取得済の詰む手の証明木(nullptr: 未取得)
   //! @param move_proof_tree 詰む手 -> 証明木のmap
   template<PlayerTurn P>
-  void UpdateDualSolution(const MovePosition move, std::map<MovePosition, MoveTree> * const move_proof_tree);
+  void UpdateDualSolution(const MovePosition move, const VLMProvedMoveTree * const generated_tree, std::map<MovePosition, VLMProvedMoveTree> * const move_proof_tree);
+
+  //! @brief 詰む手の証明木と終端局面1手前の局面のHash値を取得する
+  template<PlayerTurn P>
+  void GetProvedMoveTree(const MovePosition move, VLMProvedMoveTree * const proved_move_tree);
+
+  //! @brief 詰む手の証明木を並行して取得する
+  //! @note 現局面の複製を用いて各threadで取得する(置換表はロック制御ありで確保されていること)
+  template<PlayerTurn P>
+  void GetProvedMoveTreeParallel(const MoveList &proved_move_list, std::map<MovePosition, VLMProvedMoveTree> * const proved_move_tree);
 
   //! @brief 手順前後を検知するために終端局面直前の局面までのOR node手順のHash値を求める
   void GetPreTerminateHash(MoveTree * const proof_tree, std::set<HashValue> * const pre_terminate_hash_set) const;
 
+  //! @brief 証明木の現在のnode以下の終端局面直前の局面のHash値を求める
+  //! @param is_black_turn root nodeの手番
+  //! @param depth 現在のnodeの深さ(root node: 0)
+  //! @param parent_hash_value 親nodeまでのOR node手順のHash値
+  //! @param hash_value 現在のnodeまでのOR node手順のHash値
+  void GetPreTerminateHash(MoveTree * const proof_tree, const bool is_black_turn, const size_t depth, const HashValue parent_hash_value, const HashValue hash_value, std::set<HashValue> * const pre_terminate_hash_set) const;
+
+  //! @brief 探索ノード数, 探索時間の上限を設定する(0: 上限なし)
+  void SetSearchBudget(const std::uint64_t node_limit, const std::uint64_t time_limit);
+
+  //! @brief 探索を打ち切るかを返す
+  //! @note 探索制御による中断に加え、探索ノード数, 探索時間の上限をチェックする(時間はkBudgetCheckIntervalノードごと)
+  const bool IsSearchTerminate();
+
+  //! @brief 探索制御による中断 or 探索ノード数, 探索時間の上限により探索を打ち切ったかを返す
+  //! @note IsSearchTerminate()と異なり上限のチェック, 進捗の通知を行わない
+  const bool IsSearchInterrupted();
+
+  //! @brief 探索の進捗を通知する
+  void NotifyProgress(const bool is_iteration_end, const VLMSearchDepth search_depth, const MovePosition best_move);
+
+  //! @brief 指定の深さから反復深化で解図を行う
+  void SolveIterative(const VLMSearchDepth start_depth, const VLMSearch &vlm_search, VLMResult * const vlm_result);
+
+  //! @brief 前回の反復の結果によりroot nodeの候補手を並べ替える
+  //! @note 反証済の候補手を除き、前回の反復で展開した順序の手を先頭に並べる
+  void ReorderRootCandidateMove(const VLMResult &vlm_result, MoveList * const candidate_move) const;
+
   //! @brief OR nodeの探索
   template<PlayerTurn P>
   VLMSearchValue SolveOR(const VLMSearch &vlm_search, VLMResult * const vlm_result);
   
   VLMSearchValue SolveOR(const bool is_black_turn, const VLMSearch &vlm_search, VLMResult * const vlm_result);
 
+  //! @brief 残り深さ3のOR nodeの探索
+  //! @param hash_value 局面のHash値
+  //! @pre 局面は終端ではない
+  //! @note 詰む手は四ノビ, 三に限られるため四ノビ, 三のみを展開し、子孫ノードは再帰探索せずに評価する
+  //! @note 置換表で値が定まる子ノードは指し手を設定せずに評価する
+  //! @note 探索結果値と置換表への登録内容は通常の探索と同一
+  template<PlayerTurn P>
+  VLMSearchValue SolveShallowOR(const VLMSearch &vlm_search, const HashValue hash_value);
+
+  //! @brief 残り深さ2のAND nodeの探索
+  //! @note 子ノード(残り深さ1のOR node)は終端チェックのみで評価する
+  template<PlayerTurn P>
+  VLMSearchValue SolveShallowAND(const VLMSearch &vlm_search);
+
+  //! @brief 残り深さ2のAND nodeの終端手防手を評価する
+  //! @param hash_value AND nodeのHash値
+  //! @param guard_move 終端手防手(防手がない場合はPass)
+  //! @return 子ノード(残り深さ1のOR node)の探索結果値の最小値(詰まない防手が見つかった時点で打ち切る)
+  //! @note 置換表に登録済の子ノードと、相手に四がない局面で四ノビとなる防手(終端しない)は指し手を設定せずに評価する
+  //! @note それ以外の防手は終端チェックに開放状態を要するため、通常の探索と同じく指し手を設定する
+  template<PlayerTurn P>
+  VLMSearchValue SolveDepthTwoGuard(const VLMSearch &vlm_search, const HashValue hash_value, const MoveList &guard_move);
+
+  //! @brief VCF(四ノビ連続の勝ち)の探索
+  //! @param vlm_search 探索設定(remain_depthまでのVCFを探索する)
+  //! @param search_value 詰む場合の探索結果値の格納先
+  //! @retval true VCFがある
+  //! @note 詰む局面はOR node, AND nodeともにVLMTableに登録するためGetProofTreeで証明木を取得できる
+  template<PlayerTurn P>
+  const bool SolveVCF(const VLMSearch &vlm_search, VLMSearchValue * const search_value);
+
   //! @brief AND nodeの探索
   template<PlayerTurn P>
   VLMSearchValue SolveAND(const VLMSearch &vlm_search, VLMResult * const vlm_result);
 
+  //! @brief 防手が四の防手の1手に限られるAND nodeの探索
+  //! @param guard_move 四の防手
+  //! @note ノード数の計上, 置換表の参照を行わずに防手を指し、詰みの場合のみ置換表に登録する(証明木の取得, Simulationで参照するため)
+  //! @note 探索結果値はSolveANDと同一となる
+  template<PlayerTurn P>
+  VLMSearchValue SolveForcedAND(const VLMSearch &vlm_search, const MovePosition guard_move, VLMResult * const vlm_result);
+
   //! @brief OR nodeの指し手生成
   template<PlayerTurn P>
   void GetCandidateMoveOR(const VLMSearch &vlm_search, MoveList * const candidate_move) const;
@@ -167,7 +429,33 @@ private:
   //! @param candidate_move_bit 候補手の位置
   //! @param ソート済の指し手リストの格納先
   template<PlayerTurn P>
-  void MoveOrderingAND(MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const;
+  void MoveOrderingAND(const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const;
+
+  //! @brief 優先度表の順に区分に該当する指し手を生成する
+  //! @param ordering_table 優先度表(VLMMoveOrderingTable.h)
+  template<PlayerTurn P>
+  void MoveOrderingByTable(const MoveOrderingTable &ordering_table, const VLMSearch &vlm_search, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const;
+
+  //! @brief 指し手の順序付けの区分に該当する指し手を返す
+  //! @param ordering_bit 列挙済の区分(未列挙の区分は列挙して追加する)
+  //! @pre 残り深さが区分を用いる最小の残り深さ以上であること(GetMoveOrderingMinDepth)
+  template<PlayerTurn P>
+  const MoveBitSet& GetMoveOrderingBit(const MoveOrderingCategory category, VLMMoveOrderingBit * const ordering_bit) const;
+
+  //! @brief 詰む手, 詰みを防ぐ手の順序付けの区分の実績を更新する
+  //! @param candidate_move 候補手
+  //! @param selected_move_bit 詰むことを確認したすべての手(OR node), 詰みを防いだ手(AND node)
+  template<PlayerTurn P>
+  void UpdateMoveOrderingStat(const MoveOrderingNode node, const VLMSearch &vlm_search, const MoveList &candidate_move, const MoveBitSet &selected_move_bit);
+
+  //! @brief AND nodeの指し手を攻め側の脅威の推定値で順序付けする
+  //! @pre 相手に四ノビが生じていない
+  //! @param candidate_move_bit 候補手の位置
+  //! @param candidate_move ソート済の指し手リストの格納先
+  //! @note 防手の直線近傍にある攻め側の四ノビ点, 三を作る点(防手で消える脅威)と防手自身の四ノビ, 三から推定値を求める
+  //! @note Passは推定値0とし、推定値が同じ防手は指し手の位置順とする
+  template<PlayerTurn P>
+  void MoveOrderingThreatAND(MoveBitSet * const candidate_move_bit, MoveList * const candidate_move) const;
 
   //! @brief 証明木の生成モード
   static constexpr bool kGenerateFullTree = true;         // すべての変化を生成する
@@ -183,6 +471,33 @@ private:
   template<PlayerTurn P>
   const bool GetProofTreeAND(MoveTree * const proof_tree, const bool generate_full_tree);
 
+  //! @brief 集約した証明木の取得結果のメモを破棄する
+  void ClearSummarizedProofTreeMemo();
+
+  //! @brief 詰みを示したOR nodeの詰む手を記録する(VLMSearch::record_proof_tree指定時のみ)
+  //! @param search_value 詰みの探索値(記録済の詰みより短い場合のみ上書きする)
+  void RecordProofOR(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value, const MovePosition move);
+
+  //! @brief 詰みを示したAND nodeの防手を記録する(VLMSearch::record_proof_tree指定時のみ)
+  //! @param search_value 詰みの探索値(記録済の詰みより短い場合のみ上書きする)
+  void RecordProofAND(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value, const MoveList &move_list);
+
+  //! @brief 不詰の証明書の本体を取得する(OR node)
+  template<PlayerTurn P>
+  const bool GetDisproofCertificateOR(std::string * const certificate);
+
+  //! @brief 不詰の証明書の本体を取得する(AND node)
+  template<PlayerTurn P>
+  const bool GetDisproofCertificateAND(std::string * const certificate);
+
+  //! @brief 記録した詰む手, 防手から証明木を取得する(OR node)
+  template<PlayerTurn P>
+  const bool GetRecordedProofTreeOR(MoveTree * const proof_tree);
+
+  //! @brief 記録した詰む手, 防手から証明木を取得する(AND node)
+  template<PlayerTurn P>
+  const bool GetRecordedProofTreeAND(MoveTree * const proof_tree);
+
   static constexpr bool kCheckVLMTable = true;    // Transposition tableのチェックを行う
   static constexpr bool kScanProofTree = false;   // Transposition tableのチェックを行わず証明木の走査のみ行う
 
@@ -200,18 +515,118 @@ private:
   template<PlayerTurn P>
   VLMSearchValue SimulationAND(const VLMSearch &vlm_search, const bool check_vlm_table, MoveTree * const proof_tree);
 
+  //! @brief Simulationを行う効果があるかを実績から判定する
+  //! @param remain_depth Simulationを行うOR nodeの残り深さ
+  //! @param proof_tree_depth Simulationに用いる証明木の深さ
+  //! @param skip_count 省略すると判定した場合に加算する回数(Simulation, 証明木取得ごと)
+  //! @retval false 省略する
+  //! @note 成功率 x 通常探索の平均ノード数がSimulationの平均ノード数を下回る区分は一定間隔でのみ試行する(試行した回数は省略した回数に含めない)
+  const bool IsSimulationEffective(const VLMSearchDepth remain_depth, const size_t proof_tree_depth, std::uint64_t * const skip_count);
+
+  //! @brief Simulationの実績を更新する
+  void UpdateSimulationStat(const VLMSearchDepth remain_depth, const size_t proof_tree_depth, const bool is_success, const std::uint64_t node);
+
+  //! @brief 通常探索の実績を更新する
+  void UpdateSolveStat(const VLMSearchDepth remain_depth, const std::uint64_t node);
+
+  //! @brief Passの証明木から影響領域を求める
+  //! @param proof_tree Passした局面をroot nodeとする証明木
+  //! @param relevance_zone_bit 影響領域の格納先
+  //! @note 影響領域外の防手はPassの証明木の手順に影響しないため、Passと同一手順で詰む
+  template<PlayerTurn P>
+  void GetRelevanceZone(MoveTree * const proof_tree, MoveBitSet * const relevance_zone_bit) const;
+
+  //! @brief 証明木に現れる指し手を取得する
+  void GetProofTreeMoveBit(MoveTree * const proof_tree, MoveBitSet * const proof_tree_move_bit) const;
+
+  //! @brief 指し手集合の直線近傍(距離kRelevanceZoneDistance以内)を追加する
+  static void AddLineNeighborhood(const MoveBitSet &move_bit, MoveBitSet * const neighborhood_bit);
+
+  //! @brief 指し手の直線近傍(距離kRelevanceZoneDistance以内)を返す
+  static const MoveBitSet& GetLineNeighborhood(const MovePosition move);
+
   //! @brief 終端チェック(OR node)
   const bool IsTerminate(VLMResult * const vlm_result);
 
   //! @brief 子局面の探索結果値から現局面の探索結果値を算出する
   const VLMSearchValue GetSearchValue(const VLMSearchValue child_search_value) const;
 
+  //! @brief 置換表を検索し、残り深さでの探索結果値を返す
+  //! @param vlm_search 探索制御(残り深さ, 最短手順モード)
+  //! @param search_value 探索結果値の格納先
+  //! @retval true 置換表にデータがある
+  //! @note 残り深さより長い詰みが登録されていても残り深さ以下で詰まないことを確認済であれば弱意の不詰を返す
+  //! @note 最短手順モードでは最短であることを確認していない詰みは詰まないことを確認済の深さの弱意の不詰として返す
+  const bool FindSearchValue(const VLMSearch &vlm_search, const HashValue hash_value, VLMSearchValue * const search_value) const;
+
+  //! @brief 置換表を検索し、残り深さでの探索結果値を返す(指し手を設定していない子ノードのBitBoardで検索する)
+  const bool FindSearchValue(const VLMSearch &vlm_search, const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value) const;
+
+  //! @brief 最短手順モードで詰みを示した局面に、見つかった詰みより2手短い詰みがないことを登録する
+  void UpsertShortestBound(const VLMSearch &vlm_search, const HashValue hash_value, const VLMSearchValue search_value);
+
   //! @brief root nodeかどうかを返す
   const bool IsRootNode() const;
 
   SearchManager search_manager_;    //!< 探索制御
   MoveList search_sequence_;        //!< 探索手順
   std::shared_ptr<VLMTable> vlm_table_;   //!< 置換表
+  std::shared_ptr<VCFTable> vcf_table_;   //!< VCF探索用の置換表
+
+  //! @brief Simulationの実績([残り深さ][証明木の深さ])
+  std::array<std::array<VLMSimulationStat, kSimulationStatDepthNum>, kSimulationStatDepthNum> simulation_stat_;
+  std::array<VLMSolveStat, kSimulationStatDepthNum> solve_stat_;    //!< 通常探索の実績([残り深さ])
+  std::uint64_t simulation_skip_count_ = 0;         //!< 実績により省略したSimulationの回数
+  std::uint64_t proof_tree_skip_count_ = 0;         //!< 実績により省略した証明木取得の回数
+  std::uint64_t relevance_zone_prune_count_ = 0;    //!< 影響領域外のため枝刈りした防手の数
+  std::uint64_t depth_two_probe_count_ = 0;         //!< 残り深さ2のAND nodeで指し手を設定せずに評価した防手の数
+  std::uint64_t depth_two_move_count_ = 0;          //!< 残り深さ2のAND nodeで指し手を設定して評価した防手の数
+  std::uint64_t refutation_count_ = 0;              //!< 詰みを防ぐ防手が見つかったAND nodeの数
+  std::uint64_t refutation_node_ = 0;               //!< 詰みを防ぐ防手が見つかるまでの探索ノード数の合計
+  std::uint64_t refutation_move_count_ = 0;         //!< 詰みを防ぐ防手が見つかるまでに展開した防手の数の合計
+  std::array<MoveOrderingStatTable, kMoveOrderingNodeNum> move_ordering_stat_;    //!< ノード種別 -> 順序付けの区分の実績
+
+  std::uint64_t budget_node_limit_ = 0;                      //!< 探索を打ち切るノード数(0: 上限なし)
+  bool is_time_limited_ = false;                             //!< 探索時間の上限があるか
+  std::chrono::steady_clock::time_point budget_deadline_;    //!< 探索を打ち切る時刻
+  std::uint64_t budget_check_count_ = 0;                     //!< 探索時間の上限をチェックするためのカウンタ
+  bool is_budget_exhausted_ = false;                         //!< 探索ノード数 or 探索時間の上限に達したか
+
+  VLMProgressCallback progress_callback_;         //!< 探索の進捗の通知先
+  std::uint64_t progress_node_interval_ = 0;      //!< 探索の進捗を通知するノード数の間隔(0: 各深さの終了時のみ)
+  std::uint64_t next_progress_node_ = 0;          //!< 次に探索の進捗を通知するノード数
+  VLMSearchDepth progress_depth_ = 0;             //!< 探索中の深さ
+  const VLMResult *progress_result_ = nullptr;    //!< 探索中の解図結果(root nodeの最善手の取得用)
+
+  std::function<void()> yield_callback_;     //!< 探索を中断する関数
+  std::uint64_t yield_node_interval_ = 0;    //!< 探索を中断するノード数の間隔(0: 中断しない)
+  std::uint64_t next_yield_node_ = 0;        //!< 次に探索を中断するノード数
+
+  size_t dual_solution_thread_ = 1;         //!< 余詰判定で証明木を並行して取得するthread数
+  std::uint64_t dual_solution_time_ = 0;    //!< 余詰判定の時間[ms]
+  bool shortest_solution_ = false;          //!< 証明木に最短の詰む手のみを登録するか
+
+  //! @brief 集約した証明木の取得結果のメモ(1回の証明木取得の間のみ有効)
+  //! @note 手順前後で合流する局面は子局面のリストを共有するDAGとして保持し、証明木への展開のみ行う
+  std::map<std::pair<HashValue, VLMSearchDepth>, MoveList> summarized_or_memo_;      //!< (OR nodeのHash値, 詰みの深さ) -> 証明木に登録した詰む手
+  std::map<std::pair<HashValue, VLMSearchDepth>, MoveList> summarized_and_memo_;     //!< (AND nodeのHash値, 詰みの深さ) -> 証明木に登録した防手
+  std::map<HashValue, MoveTree> threat_proof_tree_memo_;  //!< Passした局面のHash値 -> Passした局面の証明木
+
+  //! @brief 不詰の証明書の取得結果のメモ(1回の証明書取得の間のみ有効)
+  std::map<HashValue, std::string> disproof_and_memo_;    //!< AND nodeのHash値 -> AND node以下の証明書(取得できなかった場合は空)
+  std::uint64_t disproof_certificate_node_ = 0;           //!< 証明書の取得で展開した局面数
+
+  //! @brief 探索中に記録した証明木(置換表とは異なり上書きされない)
+  //! @note 終端の詰む手はTerminateCheckで求まるため記録しない
+  //! @note 同一局面はより短い詰みを示した場合のみ上書きする(子の詰みは親より短いため、記録をたどると必ず終端に達する)
+  //! @note 記録する局面数はkMaxProofRecordNumまでとし、Solveごとに破棄する
+  std::map<HashValue, std::pair<VLMSearchValue, MovePosition>> or_proof_record_;   //!< 詰みを示したOR nodeのHash値 -> (探索値, 詰む手)
+  std::map<HashValue, std::pair<VLMSearchValue, MoveList>> and_proof_record_;      //!< 詰みを示したAND nodeのHash値 -> (探索値, 展開した防手)
+
+  //! @brief 探索手順の手数ごとの禁手のキャッシュ
+  //! @note 手数iのキャッシュは手数iの指し手を設定した時点で無効化する(UndoMoveでは局面が戻るため有効のまま)
+  mutable std::vector<MoveBitSet> forbidden_bit_cache_;    //!< 手数 -> 禁手
+  mutable std::vector<bool> forbidden_bit_cached_;         //!< 手数 -> キャッシュが有効か
 };
 
 }   // namespace realcore
@@ -0,0 +1,83 @@
+//! @file
+//! @brief 指し手の順序付けの区分を定義する
+//! @author Koichi NABETANI
+//! @date 2026/10/19
+#ifndef VLM_MOVE_ORDERING_H
+#define VLM_MOVE_ORDERING_H
+
+#include <cstdint>
+#include <array>
+
+namespace realcore{
+
+//! @brief 指し手の順序付けの区分
+//! @note 区分は重複しうる。順序付けでは優先度表の順に各区分に該当する指し手を生成する
+//! @note 手番(OR nodeは攻め側, AND nodeは受け側)から見た区分とする
+enum MoveOrderingCategory : std::uint8_t
+{
+  kOrderingFourThree,       //!< 四三
+  kOrderingDoubleThree,     //!< 三々
+  kOrderingThreatSword,     //!< (四 or 三) & 剣先点
+  kOrderingThreatMise,      //!< (四 or 三) & ミセ手
+  kOrderingMultiMise,       //!< 両ミセ
+  kOrderingMiseSword,       //!< ミセ手 & 剣先点
+  kOrderingMise,            //!< ミセ手
+  kOrderingSword,           //!< 剣先点
+  kOrderingTwo,             //!< 二ノビ
+  kOrderingFour,            //!< 四
+  kOrderingThree,           //!< 三
+  kOrderingOpponentFour,    //!< 相手の四ノビ点
+  kMoveOrderingCategoryNum,
+  kOrderingNone = kMoveOrderingCategoryNum,   //!< 優先度表の終端
+};
+
+//! @brief 区分名(学習結果のCSV, 優先度表の生成で用いる)
+constexpr const char* kMoveOrderingCategoryName[kMoveOrderingCategoryNum] = {
+  "FourThree", "DoubleThree", "ThreatSword", "ThreatMise", "MultiMise", "MiseSword",
+  "Mise", "Sword", "Two", "Four", "Three", "OpponentFour"
+};
+
+//! @brief 区分を用いる最小の残り深さを返す
+//! @note 残り深さに応じて更新する開放状態が異なるため、ミセ手, 剣先点, 二は残り深さ5以上でのみ判定できる
+constexpr int GetMoveOrderingMinDepth(const MoveOrderingCategory category)
+{
+  return (category == kOrderingFourThree || category == kOrderingDoubleThree || category == kOrderingThreatSword) ? 3 :
+    (category == kOrderingThreatMise || category == kOrderingMultiMise || category == kOrderingMiseSword ||
+     category == kOrderingMise || category == kOrderingSword || category == kOrderingTwo) ? 5 : 0;
+}
+
+//! @brief 順序付けを行うノードの種別
+enum MoveOrderingNode : std::uint8_t
+{
+  kOrderingORBlack,     //!< OR node(黒番)
+  kOrderingORWhite,     //!< OR node(白番)
+  kOrderingANDBlack,    //!< AND node(黒番)
+  kOrderingANDWhite,    //!< AND node(白番)
+  kMoveOrderingNodeNum,
+};
+
+//! @brief ノード種別名
+constexpr const char* kMoveOrderingNodeName[kMoveOrderingNodeNum] = {
+  "ORBlack", "ORWhite", "ANDBlack", "ANDWhite"
+};
+
+//! @brief 指し手の順序付けの優先度表(kOrderingNoneで終端する)
+typedef std::array<MoveOrderingCategory, kMoveOrderingCategoryNum> MoveOrderingTable;
+
+//! @brief 区分ごとの詰む手, 詰みを防ぐ手の実績
+typedef struct structMoveOrderingStat
+{
+  structMoveOrderingStat()
+  : candidate_count(0), selected_count(0)
+  {
+  }
+
+  std::uint64_t candidate_count;    //!< 区分に該当した候補手の数
+  std::uint64_t selected_count;     //!< 区分に該当した詰む手(OR node), 詰みを防ぐ手(AND node)の数
+}MoveOrderingStat;
+
+typedef std::array<MoveOrderingStat, kMoveOrderingCategoryNum> MoveOrderingStatTable;   //!< 区分 -> 実績
+
+}   // namespace realcore
+
+#endif    // VLM_MOVE_ORDERING_H
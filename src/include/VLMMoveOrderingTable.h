@@ -0,0 +1,32 @@
+//! @file
+//! @brief 指し手の順序付けの優先度表
+//! @note cui_batch/generate_move_ordering_table.pyで生成する(vlm_analyzer_batch --train-orderingの学習結果から再生成できる)
+//! @note 既定値: doc/02_performance/vlm_analyzer_performance.pptx, 「OR nodeの指し手」, vlm_analyzer_performance.xlsx, MoveOrderingAND sheet
+#ifndef VLM_MOVE_ORDERING_TABLE_H
+#define VLM_MOVE_ORDERING_TABLE_H
+
+#include "VLMMoveOrdering.h"
+
+namespace realcore{
+
+constexpr MoveOrderingTable kMoveOrderingORBlack = {{
+  kOrderingFourThree, kOrderingThreatMise, kOrderingMultiMise, kOrderingSword, kOrderingTwo,
+  kOrderingFour, kOrderingThree, kOrderingNone
+}};
+
+constexpr MoveOrderingTable kMoveOrderingORWhite = {{
+  kOrderingFourThree, kOrderingDoubleThree, kOrderingThreatSword, kOrderingThreatMise, kOrderingMultiMise,
+  kOrderingMiseSword, kOrderingSword, kOrderingTwo, kOrderingFour, kOrderingThree, kOrderingNone
+}};
+
+constexpr MoveOrderingTable kMoveOrderingANDBlack = {{
+  kOrderingThree, kOrderingOpponentFour, kOrderingNone
+}};
+
+constexpr MoveOrderingTable kMoveOrderingANDWhite = {{
+  kOrderingThree, kOrderingOpponentFour, kOrderingNone
+}};
+
+}   // namespace realcore
+
+#endif    // VLM_MOVE_ORDERING_TABLE_H
@@ -26,6 +26,77 @@ static constexpr bool kDefaultVLMTableLockFree = false;
 //! @brief 置換表ではデフォルトではInterruption ExceptionをCatchしない
 static constexpr bool kDefaultNoInterruptionException = false;
 
+//! @brief Simulation実績を管理する深さの上限(残り深さ, 証明木の深さともにこの値以上は同一区分とする)
+static constexpr std::size_t kSimulationStatDepthNum = 32;
+
+//! @brief Simulationの打ち切り判定を行うのに必要な試行回数
+static constexpr std::uint64_t kSimulationSampleCount = 64;
+
+//! @brief Simulationを打ち切っている区分でも実績更新のため試行する間隔
+static constexpr std::uint64_t kSimulationProbeInterval = 16;
+
+//! @brief 探索時間の上限をチェックするノード数の間隔
+static constexpr std::uint64_t kBudgetCheckInterval = 1024;
+
+//! @brief 探索中に記録する証明木の局面数の上限(OR node, AND nodeそれぞれ)
+//! @note 上限に達した後は未記録の局面を記録しない(記録から証明木を取得できない場合は置換表から取得する)
+static constexpr std::size_t kMaxProofRecordNum = 1 << 20;
+
+//! @brief 中断・再開しながら解図を行う場合のcoroutineのstackサイズ(8MB)
+//! @note 解図は探索深さに比例した再帰呼び出しとなるため、通常のthreadのstackと同程度を確保する
+static constexpr std::size_t kSlicedSolverStackSize = 8 * 1024 * 1024;
+
+//! @brief VCF探索用置換表のサイズ(16MB)
+static constexpr std::size_t kDefaultVCFTableSpace = 16;
+
+//! @brief VCF探索用置換表を指定せずにVLMAnalyzerを生成した場合のVCF探索用置換表のサイズ(最小)
+//! @note 問題ごとにVLMAnalyzerを生成する場合に問題ごとに確保しないため最小とする(workerごとに確保したものを指定する)
+static constexpr std::size_t kMinimumVCFTableSpace = 0;
+
+//! @brief 解図結果キャッシュのファイル形式
+//! @note 形式: ヘッダ(kResultCacheMagic, バージョン, エントリ数, エントリのサイズ), エントリの配列(対称変換で正規化した局面のHash値で配置する)
+static constexpr char kResultCacheMagic[] = "VLMR";
+static constexpr std::uint32_t kResultCacheVersion = 1;
+
+//! @brief 解図結果キャッシュのエントリ数の既定値(1エントリ約4.5KB)
+static constexpr std::size_t kDefaultResultCacheEntryNum = 16384;
+
+//! @brief 解図結果キャッシュの1エントリに保存する証明木, 余詰, 最善応手の文字列の合計の最大長(超える場合は保存しない)
+static constexpr std::size_t kResultCacheTextSize = 4096;
+
+//! @brief VCFの事前チェックを行う最小の残り深さ
+static constexpr int kVCFMinDepth = 5;
+
+//! @brief 不詰の証明書(バイナリ形式)のヘッダ
+//! @note 形式: "VLMD", バージョン(1byte), 局面の手数(1byte), 局面の指し手(1byte/手), 本体
+//! @note 本体: AND nodeは終端(kDisproofTerminalTag) or 防手(kDisproofGuardTag + 指し手)とし、防手の後にOR nodeを続ける
+//! @note OR node: 例外の候補手の数(1byte), (候補手(1byte) + AND node) * 例外の数, 既定のAND nodeの有無(kDisproofDefaultTag or kDisproofNoDefaultTag), 既定のAND node
+//! @note 例外以外の候補手(詰みを防ぐ手順に関係しない手)はすべて既定のAND nodeで強意の不詰となるため、空点ごとに記録しない
+static constexpr char kDisproofCertificateMagic[] = "VLMD";
+static constexpr std::uint8_t kDisproofCertificateVersion = 2;
+
+//! @brief 不詰の証明書のAND nodeの種別
+static constexpr std::uint8_t kDisproofTerminalTag = 'T';   // 防御側が終端(勝ち)
+static constexpr std::uint8_t kDisproofGuardTag = 'G';      // 防手で強意の不詰となる
+
+//! @brief 不詰の証明書のOR nodeの既定のAND nodeの有無
+static constexpr std::uint8_t kDisproofDefaultTag = 'D';      // 既定のAND nodeあり
+static constexpr std::uint8_t kDisproofNoDefaultTag = 'N';    // 既定のAND nodeなし(すべての候補手が例外)
+
+//! @brief 不詰の証明書の取得で展開する局面数の上限(超えた場合は証明書を取得しない)
+static constexpr std::uint64_t kDisproofCertificateNodeLimit = 1 << 20;
+
+//! @brief 脅威の推定によるAND nodeの防手の順序付けの重み
+//! @note 防手の直線近傍にある攻め側の四ノビ点, 三を作る点は防手で消える脅威とみなし、消える脅威が多い防手から展開する
+static constexpr int kThreatOrderingFourWeight = 4;         // 攻め側の四ノビ点
+static constexpr int kThreatOrderingThreeWeight = 2;        // 攻め側の三を作る点
+static constexpr int kThreatOrderingOwnFourWeight = 3;      // 防手が受け側の四ノビ
+static constexpr int kThreatOrderingOwnThreeWeight = 2;     // 防手が受け側の三を作る手
+
+//! @brief 影響領域とみなす直線近傍の距離
+//! @note 達四, 五連, 長連の判定は着手位置から直線上の距離5以内の盤面で決まる
+static constexpr int kRelevanceZoneDistance = 5;
+
 // VLM Analyzer用(黒)の空点情報の更新(深さ1)
 static constexpr uint64_t kUpdateFlagVLMAnalyzerDepthOneBlack = 
   kUpdateFlagOpenFourBlack;   // OR node(黒)での終端チェック
@@ -0,0 +1,73 @@
+//! @file
+//! @brief 証明木の検証を行うクラス
+//! @author Koichi NABETANI
+//! @date 2026/10/19
+#ifndef VLM_PROOF_VERIFIER_H
+#define VLM_PROOF_VERIFIER_H
+
+#include "VLMAnalyzer.h"
+
+namespace realcore{
+
+//! @brief 証明木を探索を行わずに検証するクラス
+//! @note 置換表を用いず、盤面上で証明木の手順を再生して検証する
+//! @note OR node: 証明木のいずれかの手(候補手であること)で詰む or 終端(TerminateCheck)であること
+//! @note AND node: すべての防手(GetCandidateMoveAND)が証明木にある or Passの証明木の手順で詰むこと
+class VLMProofVerifier
+{
+public:
+  //! @param board_move_sequence 証明木のroot nodeの局面
+  VLMProofVerifier(const MoveList &board_move_sequence);
+
+  //! @brief 証明木が詰みを示しているかを検証する
+  //! @param proof_tree 検証する証明木(集約した証明木も検証できる)
+  //! @param thread_num root nodeの詰む手, 防手ごとの部分木を並行して検証するthread数
+  //! @retval true 証明木が詰みを示している
+  const bool Verify(const MoveTree &proof_tree, const size_t thread_num) const;
+
+  //! @brief 強意の不詰の証明書が正しいかを検証する
+  //! @param certificate VLMAnalyzer::GetDisproofCertificateで取得した証明書
+  //! @retval true 証明書がroot nodeの局面の強意の不詰を示している
+  const bool VerifyDisproofCertificate(const std::string &certificate) const;
+
+private:
+  //! @brief 独立して検証する部分木(root nodeの詰む手 -> 防手)
+  typedef struct structVerifyTask
+  {
+    size_t attack_index;          // root nodeの詰む手のindex
+    MovePosition attack_move;     // root nodeの詰む手
+    MovePosition guard_move;      // 防手
+    MovePosition tree_move;       // 防手に対応する証明木の手(証明木にない防手はPass)
+  }VerifyTask;
+
+  template<PlayerTurn P>
+  const bool VerifyRoot(const MoveTree &proof_tree, const size_t thread_num) const;
+
+  //! @brief 証明木の検証(OR node)
+  template<PlayerTurn P>
+  static const bool VerifyOR(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree);
+
+  //! @brief 証明木の検証(AND node)
+  template<PlayerTurn P>
+  static const bool VerifyAND(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree);
+
+  //! @brief AND nodeの各防手に対応する証明木の手を求める
+  //! @retval false 証明木に防手もPassもない防手がある or 終端している
+  template<PlayerTurn P>
+  static const bool GetGuardTreeMove(VLMAnalyzer * const vlm_analyzer, MoveTree * const proof_tree, MoveList * const guard_move, MoveList * const tree_move);
+
+  //! @brief 不詰の証明書の検証(OR node)
+  //! @param position 証明書の読み込み位置
+  template<PlayerTurn P>
+  static const bool VerifyDisproofOR(VLMAnalyzer * const vlm_analyzer, const std::string &certificate, size_t * const position);
+
+  //! @brief 不詰の証明書の検証(AND node)
+  template<PlayerTurn P>
+  static const bool VerifyDisproofAND(VLMAnalyzer * const vlm_analyzer, const std::string &certificate, size_t * const position);
+
+  MoveList board_move_sequence_;    //!< 証明木のroot nodeの局面
+};
+
+}   // namespace realcore
+
+#endif    // VLM_PROOF_VERIFIER_H
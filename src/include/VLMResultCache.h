@@ -0,0 +1,123 @@
+//! @file
+//! @brief 解図結果をファイルに永続化するキャッシュ
+//! @author Koichi NABETANI
+//! @date 2026/10/19
+#ifndef VLM_RESULT_CACHE_H
+#define VLM_RESULT_CACHE_H
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <mutex>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "VLMAnalyzer.h"
+
+namespace realcore{
+
+//! @brief 解図結果キャッシュのヘッダ
+typedef struct structResultCacheHeader
+{
+  char magic[4];                  //!< kResultCacheMagic
+  std::uint32_t version;          //!< kResultCacheVersion
+  std::uint64_t entry_num;        //!< エントリ数
+  std::uint64_t entry_size;       //!< エントリのサイズ
+}ResultCacheHeader;
+
+//! @brief 解図結果キャッシュのエントリ(ファイルにそのまま配置する)
+//! @note 局面, 証明木等は対称変換で正規化した向きで保存する
+typedef struct structResultCacheEntry
+{
+  HashValue hash_value;           //!< 正規化した局面のHash値
+  std::uint8_t is_used;           //!< 使用中か
+  std::uint8_t result_flag;       //!< 解図結果(kResultCacheFlag*の論理和)
+  VLMSearchDepth search_depth;    //!< 詰み, 強意の不詰を示した深さ(詰みも強意の不詰もない場合は確認済の深さ)
+  std::uint16_t proof_tree_size;        //!< 証明木の文字列長
+  std::uint16_t dual_solution_size;     //!< 余詰の変化の文字列長
+  std::uint16_t best_response_size;     //!< 最善応手の文字列長
+  std::uint8_t stone_num;               //!< 石数
+  std::array<std::uint8_t, kInBoardMoveNum> stone;    //!< 正規化した局面の石(黒石の昇順, 白石の昇順)
+  std::array<char, kResultCacheTextSize> text;        //!< 証明木, 余詰の変化, 最善応手の文字列
+}ResultCacheEntry;
+
+//! @brief 解図結果のフラグ
+static constexpr std::uint8_t kResultCacheFlagSolved = 0x01;          //!< 詰み
+static constexpr std::uint8_t kResultCacheFlagDisproved = 0x02;       //!< 強意の不詰
+static constexpr std::uint8_t kResultCacheFlagDualSearched = 0x04;    //!< 余詰判定済
+static constexpr std::uint8_t kResultCacheFlagDualSolution = 0x08;    //!< 余詰あり
+static constexpr std::uint8_t kResultCacheFlagShortest = 0x10;        //!< 最短手順であることを証明済
+
+//! @brief 対称変換で正規化した局面をキーとする解図結果のキャッシュ
+//! @note メモリマップしたファイルに保存し、プロセスをまたいで再利用する(同一ファイルを複数プロセスから同時に更新しないこと)
+//! @note 深さdで詰む局面は深さd以上の要求に詰みを返し、深さd未満の要求には詰まないことを返す
+//! @note 強意の不詰(受け側に勝ちがある)は深さによらないため、すべての要求に強意の不詰を返す
+//! @note 詰みも強意の不詰もない局面は確認済の深さ以下の要求にのみ結果を返す。探索を中断した結果は保存しない
+//! @note VLMAnalyzerはキャッシュを参照しないため、解図の前後に呼び出し側でFind, Upsertを行う
+class VLMResultCache
+{
+public:
+  //! @param cache_path キャッシュファイルのパス(存在しない or 形式が異なる場合は作成する)
+  //! @param entry_num エントリ数
+  VLMResultCache(const std::string &cache_path, const size_t entry_num);
+
+  ~VLMResultCache();
+
+  //! @brief キャッシュファイルを開けたかを返す
+  const bool IsOpen() const;
+
+  //! @brief 解図結果を取得する
+  //! @param board_sequence 開始局面
+  //! @param vlm_search 解図設定
+  //! @param vlm_result 解図結果の格納先(取得できた場合のみ上書きする)
+  //! @retval true 取得できた
+  const bool Find(const MoveList &board_sequence, const VLMSearch &vlm_search, VLMResult * const vlm_result) const;
+
+  //! @brief 解図結果を保存する
+  //! @param board_sequence 開始局面
+  //! @param vlm_search 解図設定
+  //! @param vlm_result 解図結果(探索ノード数 or 探索時間の上限で中断した結果は保存しない)
+  //! @note 同一局面の詰みは、保存済の結果が余詰判定, 最短手順の証明を包含する場合は上書きしない
+  //! @note 証明木が同一の場合は保存済の結果の余詰判定, 最短手順の証明を引き継ぐ
+  void Upsert(const MoveList &board_sequence, const VLMSearch &vlm_search, const VLMResult &vlm_result);
+
+  //! @brief 解図結果を取得できた回数を返す
+  const std::uint64_t GetHitCount() const;
+
+private:
+  //! @brief 局面を対称変換で正規化する
+  //! @param board_sequence 局面
+  //! @param symmetry 局面を正規化する対称変換
+  //! @param stone 正規化した局面の石(黒石の昇順, 白石の昇順)
+  //! @param hash_value 正規化した局面のHash値
+  //! @retval true 正規化できた(盤外の手(Pass等)を含む場合はfalse)
+  static const bool GetCanonicalBoard(const MoveList &board_sequence, BoardSymmetry * const symmetry, std::vector<std::uint8_t> * const stone, HashValue * const hash_value);
+
+  //! @brief 対称変換の逆変換を返す
+  static const BoardSymmetry GetInverseSymmetry(const BoardSymmetry symmetry);
+
+  //! @brief 木を対称変換する
+  //! @param symmetry 対称変換
+  //! @param move_tree 変換する木(現在のノード以下を変換する)
+  //! @param symmetric_tree 変換した木(現在のノードに子を追加する)
+  static void GetSymmetricMoveTree(const BoardSymmetry symmetry, MoveTree * const move_tree, MoveTree * const symmetric_tree);
+
+  //! @brief 指し手のリストを対称変換する
+  static void GetSymmetricMoveList(const BoardSymmetry symmetry, const MoveList &move_list, MoveList * const symmetric_list);
+
+  //! @brief Hash値に対応するエントリを返す
+  ResultCacheEntry& GetEntry(const HashValue hash_value) const;
+
+  boost::interprocess::mapped_region mapped_region_;    //!< キャッシュファイルをマップした領域
+  ResultCacheEntry *entry_;     //!< エントリの配列(マップした領域内)
+  size_t entry_num_;            //!< エントリ数
+  mutable std::atomic<std::uint64_t> hit_count_;   //!< 解図結果を取得できた回数(Findはエントリのmutexの外で加算するためatomic)
+
+  mutable std::mutex mutex_;    //!< エントリのmutex
+};
+
+}   // namespace realcore
+
+#endif    // VLM_RESULT_CACHE_H
@@ -0,0 +1,60 @@
+//! @file
+//! @brief 指定ノード数ごとに中断・再開しながら解図を行うクラス
+//! @author Koichi NABETANI
+//! @date 2026/10/19
+#ifndef VLM_SLICED_SOLVER_H
+#define VLM_SLICED_SOLVER_H
+
+#include <cstdint>
+#include <memory>
+
+#include <boost/coroutine2/coroutine.hpp>
+
+#include "VLMAnalyzer.h"
+
+namespace realcore{
+
+//! @brief 解図を指定ノード数(quantum)ずつ実行するクラス
+//! @note Solveをcoroutine上で実行し、quantumを使い切るとyieldする。盤面, 探索手順, 置換表は中断中も保持される
+//! @note 少数のthreadで多数の解図を時分割で実行するためのもの(1つのインスタンスを複数threadから同時に実行しないこと)
+class VLMSlicedSolver
+{
+public:
+  VLMSlicedSolver(const MoveList &board_move_sequence, const std::shared_ptr<VLMTable> &vlm_table, const VLMSearch &vlm_search);
+
+  //! @note coroutineがthisを保持するため、複製・移動はできない
+  VLMSlicedSolver(const VLMSlicedSolver &) = delete;
+  VLMSlicedSolver(VLMSlicedSolver &&) = delete;
+  VLMSlicedSolver& operator=(const VLMSlicedSolver &) = delete;
+  VLMSlicedSolver& operator=(VLMSlicedSolver &&) = delete;
+
+  //! @brief 解図を再開し、node_quantumノード探索するか解図が終了するまで実行する
+  //! @param node_quantum 1回の実行で探索するノード数の目安
+  //! @retval true 解図が終了した
+  const bool Run(const std::uint64_t node_quantum);
+
+  //! @brief 解図が終了したかを返す
+  const bool IsFinished() const;
+
+  //! @brief 解図結果を返す
+  //! @pre IsFinished() == true
+  const VLMResult& GetResult() const;
+
+  //! @brief 解図を行うVLMAnalyzerを返す
+  const VLMAnalyzer& GetAnalyzer() const;
+
+private:
+  typedef boost::coroutines2::coroutine<void> SolveCoroutine;
+
+  VLMAnalyzer vlm_analyzer_;    //!< 解図を行うVLMAnalyzer
+  VLMSearch vlm_search_;        //!< 解図設定
+  VLMResult vlm_result_;        //!< 解図結果
+  
+  std::unique_ptr<SolveCoroutine::pull_type> solve_coroutine_;    //!< Solveを実行するcoroutine
+  SolveCoroutine::push_type *yield_;      //!< Solveを中断して呼び出し元に戻るためのcoroutine
+  bool is_finished_;    //!< 解図が終了したか
+};
+
+}   // namespace realcore
+
+#endif    // VLM_SLICED_SOLVER_H
@@ -6,7 +6,9 @@
 #define VLM_TRANSPOSITION_TABLE_H
 
 #include <array>
+#include <atomic>
 #include <vector>
+#include <mutex>
 
 #include "HashTable.h"
 #include "VLMParameter.h"
@@ -18,29 +20,30 @@ typedef std::int16_t VLMSearchValue;   //!< 探索結果を表す値
 // 盤面をHash値で持つ場合のデータ構造
 typedef struct structVLMHashData{
   structVLMHashData()
-  : hash_value(0), logic_counter(0), search_value(0)
+  : hash_value(0), logic_counter(0), search_value(0), disproved_depth(0)
   {
   }
 
   structVLMHashData(const HashValue hash, const VLMSearchValue search)
-  : hash_value(hash), search_value(search)
+  : hash_value(hash), search_value(search), disproved_depth(0)
   {
   }
   
   HashValue hash_value;               // Hash値
   TableLogicCounter logic_counter;    // 論理カウンタ
   VLMSearchValue search_value;        // 探索結果
+  std::int16_t disproved_depth;       // 詰まないことを確認済の深さ(詰みの深さの下限)
 }VLMHashData;
 
 // 盤面情報をすべて持つ場合のデータ構造
 typedef struct structVLMExactData{
   structVLMExactData()
-  : hash_value(0), board{{0}}, logic_counter(0), search_value(0)
+  : hash_value(0), board{{0}}, logic_counter(0), search_value(0), disproved_depth(0)
   {
   }
 
   structVLMExactData(const HashValue hash, const VLMSearchValue search)
-  : hash_value(hash), board{{0}}, logic_counter(0), search_value(search)
+  : hash_value(hash), board{{0}}, logic_counter(0), search_value(search), disproved_depth(0)
   {
   }
 
@@ -48,6 +51,7 @@ typedef struct structVLMExactData{
   std::array<StateBit,8> board;                  // 盤面情報
   TableLogicCounter logic_counter;    // 論理カウンタ
   VLMSearchValue search_value;        // 探索結果
+  std::int16_t disproved_depth;       // 詰まないことを確認済の深さ(詰みの深さの下限)
 }VLMExactData;
 
 #if kUseExactBoardInfo
@@ -56,6 +60,23 @@ typedef VLMExactData VLMTableData;
 typedef VLMHashData VLMTableData;
 #endif
 
+// VCF探索で四ノビ連続の勝ちがないことを確認したデータ
+typedef struct structVCFTableData{
+  structVCFTableData()
+  : hash_value(0), logic_counter(0), disproved_depth(0)
+  {
+  }
+
+  structVCFTableData(const HashValue hash, const std::int16_t depth)
+  : hash_value(hash), logic_counter(0), disproved_depth(depth)
+  {
+  }
+
+  HashValue hash_value;               // Hash値
+  TableLogicCounter logic_counter;    // 論理カウンタ
+  std::int16_t disproved_depth;       // VCFがないことを確認済の深さ
+}VCFTableData;
+
 // 前方宣言
 class BitBoard;
 
@@ -70,6 +91,7 @@ public:
   //! @param hash_value 局面のハッシュ値
   //! @param bit_board 現局面のBitBoard
   //! @param search_value 登録する探索結果
+  //! @note 同一局面の登録済データの詰まないことを確認済の深さは引き継ぐ(詰み, 浅い深さの弱意の不詰を登録しても失わない)
   void Upsert(const HashValue hash_value, const BitBoard &bit_board, const VLMSearchValue search_value);
 
   //! @brief 置換表の検索を行う
@@ -77,15 +99,52 @@ public:
   //! @retval true 置換表にデータがある
   const bool find(const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value) const;
 
+  //! @brief 置換表の検索を行う
+  //! @param search_value 探索結果の格納先
+  //! @param disproved_depth 詰まないことを確認済の深さの格納先(未確認の場合は0)
+  //! @retval true 置換表にデータがある
+  const bool find(const HashValue hash_value, const BitBoard &bit_board, VLMSearchValue * const search_value, std::int16_t * const disproved_depth) const;
+
   //! @brief 置換表の定義情報を取得する
   std::string GetDefinitionInfo() const;
 
+  //! @brief 置換表の使用率を返す
+  //! @note 空き要素への登録数から算出する概算値(並行登録で同じ空き要素に登録した場合は誤差を含む)
+  const double GetFillRate() const;
+
   //! @brief 初期化を行う
   void Initialize();
 
 private:
   HashTable<VLMTableData> hash_table_;
   std::vector<VLMTableData> proved_data_list_;    // 証明木を取得するため詰むデータを記録する
+  std::atomic<std::uint64_t> entry_count_;     // 空き要素に登録した数(複数threadから登録するためatomic)
+
+  bool lock_control_;     // ロック制御を行うか
+  mutable std::mutex proved_data_mutex_;    // proved_data_list_のmutex(ロック制御を行う場合のみ使用する)
+};
+
+//! @brief VCF探索用の置換表
+//! @note VCFがないことのみを記録する(詰みはVLMTableに記録する)ため、Hash値の衝突はVCFの見逃しにしかならない
+class VCFTable
+{
+public:
+  //! @brief 置換表を確保する
+  //! @param table_mb_size HashTableのサイズ(MB)
+  VCFTable(const size_t table_space, const bool lock_control);
+
+  //! @brief VCFがないことを確認した深さを登録する
+  void Upsert(const HashValue hash_value, const std::int16_t disproved_depth);
+
+  //! @brief VCFがないことを確認済の深さを検索する
+  //! @retval true 置換表にデータがある
+  const bool find(const HashValue hash_value, std::int16_t * const disproved_depth) const;
+
+  //! @brief 初期化を行う
+  void Initialize();
+
+private:
+  HashTable<VCFTableData> hash_table_;
 };
 
 }   // namespace realcore
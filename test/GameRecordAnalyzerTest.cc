@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include "GameRecordAnalyzer.h"
+
+using namespace std;
+using namespace realcore;
+
+class GameRecordAnalyzerTest
+: public ::testing::Test
+{
+public:
+  void SharedTableTest()
+  {
+    // 攻め側ごとに置換表を共有して各局面を解図した結果が、局面ごとに置換表を確保して解図した結果と一致することを確認する
+    const MoveList game_record("hhhgihigjhaafgabffbalgbblfgh");    // 最終局面は四三(LH)で詰む
+
+    VLMSearch vlm_search;
+    vlm_search.remain_depth = 7;
+    vlm_search.detect_dual_solution = false;
+
+    GameRecordAnalyzer game_record_analyzer(game_record, 0);
+    game_record_analyzer.Run(2, vlm_search);
+
+    const auto &result_list = game_record_analyzer.result_list_;
+    ASSERT_EQ(game_record.size() + 1, result_list.size());
+
+    for(size_t ply=0; ply<result_list.size(); ply++){
+      MoveList board_sequence;
+
+      for(size_t i=0; i<ply; i++){
+        board_sequence += game_record[i];
+      }
+
+      const auto &result = result_list[ply];
+      ASSERT_EQ(board_sequence.IsBlackTurn(), result.is_black_turn);
+
+      if(!IsNonTerminateNormalSequence(board_sequence)){
+        ASSERT_FALSE(result.is_analyzed);
+        continue;
+      }
+
+      ASSERT_TRUE(result.is_analyzed);
+
+      VLMAnalyzer vlm_analyzer(board_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+      ASSERT_EQ(vlm_result.solved, result.vlm_result.solved) << ply;
+      ASSERT_EQ(vlm_result.disproved, result.vlm_result.disproved) << ply;
+      ASSERT_EQ(vlm_result.search_depth, result.vlm_result.search_depth) << ply;
+    }
+
+    ASSERT_TRUE(result_list.back().vlm_result.solved);
+  }
+};
+
+TEST_F(GameRecordAnalyzerTest, SharedTableTest)
+{
+  SharedTableTest();
+}
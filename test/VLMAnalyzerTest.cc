@@ -1,7 +1,13 @@
+#include <random>
+#include <type_traits>
+
 #include "gtest/gtest.h"
 
 #include "VLMTranspositionTable.h"
 #include "VLMAnalyzer.h"
+#include "VLMSlicedSolver.h"
+#include "VLMProofVerifier.h"
+#include "VLMResultCache.h"
 
 using namespace std;
 
@@ -256,124 +262,1834 @@ public:
       vlm_analyzer.UndoMove();
     }
   }
-};
 
-TEST_F(VLMAnalyzerTest, MakeMoveUndoTest){
-  MakeMoveUndoTest();
-}
+  //! @brief 石の直線近傍に着手してランダムな局面を生成する(終端局面となる場合はその直前で止める)
+  void GenerateRandomPosition(const size_t max_stone_count, mt19937 * const random_engine, MoveList * const board_move_sequence)
+  {
+    assert(random_engine != nullptr);
+    assert(board_move_sequence != nullptr);
 
-TEST_F(VLMAnalyzerTest, GetCandidateMoveORTest){
-  GetCandidateMoveORTest();
-}
+    VLMAnalyzer generator(MoveList("hh"), vlm_table);
+    uniform_int_distribution<size_t> stone_count_distribution(2, max_stone_count);
+    const size_t stone_count = stone_count_distribution(*random_engine);
 
-TEST_F(VLMAnalyzerTest, GetCandidateMoveANDTest){
-  GetCandidateMoveANDTest();
-}
+    while(generator.board_move_sequence_.size() < stone_count){
+      MovePosition terminating_move;
 
-TEST_F(VLMAnalyzerTest, IsVLMProvedTest){
-  ASSERT_FALSE(IsVLMProved(kVLMStrongDisproved));
-  ASSERT_FALSE(IsVLMProved(kVLMWeakDisprovedLB));
-  ASSERT_FALSE(IsVLMProved(kVLMWeakDisprovedUB));
-  ASSERT_TRUE( IsVLMProved(kVLMProvedLB));
-  ASSERT_TRUE( IsVLMProved(kVLMProvedUB));
-}
+      if(generator.TerminateCheck(&terminating_move)){
+        break;
+      }
 
-TEST_F(VLMAnalyzerTest, IsVLMDisprovedTest){
-  ASSERT_TRUE( IsVLMDisproved(kVLMStrongDisproved));
-  ASSERT_FALSE(IsVLMDisproved(kVLMWeakDisprovedLB));
-  ASSERT_FALSE(IsVLMDisproved(kVLMWeakDisprovedUB));
-  ASSERT_FALSE(IsVLMDisproved(kVLMProvedLB));
-  ASSERT_FALSE(IsVLMDisproved(kVLMProvedUB));
-}
+      MoveBitSet stone_bit, neighborhood_bit, open_bit, forbidden_bit;
 
-TEST_F(VLMAnalyzerTest, IsVLMWeakDisprovedTest){
-  ASSERT_FALSE(IsVLMWeakDisproved(kVLMStrongDisproved));
-  ASSERT_TRUE( IsVLMWeakDisproved(kVLMWeakDisprovedLB));
-  ASSERT_TRUE( IsVLMWeakDisproved(kVLMWeakDisprovedUB));
-  ASSERT_FALSE(IsVLMWeakDisproved(kVLMProvedLB));
-  ASSERT_FALSE(IsVLMWeakDisproved(kVLMProvedUB));
-}
+      for(const auto move : generator.board_move_sequence_){
+        stone_bit.set(move);
+      }
 
-TEST_F(VLMAnalyzerTest, GetVLMDepthTest){
+      VLMAnalyzer::AddLineNeighborhood(stone_bit, &neighborhood_bit);
+      generator.EnumerateForbiddenMoves(&forbidden_bit);
+      generator.board_move_sequence_.GetOpenMove(forbidden_bit, &open_bit);
+      neighborhood_bit &= open_bit;
+
+      MoveList neighborhood_move;
+      GetMoveList(neighborhood_bit, &neighborhood_move);
+      ASSERT_FALSE(neighborhood_move.empty());
+
+      uniform_int_distribution<size_t> move_distribution(0, neighborhood_move.size() - 1);
+      generator.MakeMove(neighborhood_move[move_distribution(*random_engine)]);
+    }
+
+    *board_move_sequence = generator.board_move_sequence_;
+  }
+
+  //! @brief 四三(LH)で詰む局面と、その詰みを示す探索制御(残り深さ7, 余詰探索なし)を取得する
+  void GetFourThreeProblem(MoveList * const board_move_sequence, VLMSearch * const vlm_search)
   {
-    constexpr VLMSearchValue value = kVLMProvedUB;
-    ASSERT_EQ(1, GetVLMDepth(value));
+    assert(board_move_sequence != nullptr);
+    assert(vlm_search != nullptr);
+
+    *board_move_sequence = MoveList("hhhgihigjhaafgabffbalgbblfgh");
+    *vlm_search = VLMSearch();
+    vlm_search->remain_depth = 7;
+    vlm_search->detect_dual_solution = false;
   }
+
+  //! @brief 強意の不詰となる局面と探索制御(残り深さ7, 余詰探索なし)を取得する
+  //! @note 白の三が2つあり、黒は四ノビ, 三を作る手がないため、黒のどの手にも白の達四が残る
+  void GetDoubleThreeProblem(MoveList * const board_move_sequence, VLMSearch * const vlm_search)
   {
-    constexpr VLMSearchValue value = kVLMProvedLB;
-    ASSERT_EQ(225, GetVLMDepth(value));
+    assert(board_move_sequence != nullptr);
+    assert(vlm_search != nullptr);
+
+    *board_move_sequence = MoveList("hheecjfejcgeoolj" "aolknall");
+    *vlm_search = VLMSearch();
+    vlm_search->remain_depth = 7;
+    vlm_search->detect_dual_solution = false;
   }
+
+  void SolveShallowORTest()
   {
-    constexpr VLMSearchValue value = kVLMWeakDisprovedUB;
-    ASSERT_EQ(1, GetVLMDepth(value));
+    // ランダムに生成した局面で残り深さ3の専用ルーチンと通常の探索の結果が一致することを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 200;
+    constexpr size_t kMaxStoneCount = 24;
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+
+      const bool is_black_turn = board_move_sequence.size() % 2 == 0;
+
+      for(const bool detect_dual_solution : {false, true}){
+        VLMSearch vlm_search;
+        vlm_search.remain_depth = 3;
+        vlm_search.detect_dual_solution = detect_dual_solution;
+
+        VLMSearch generic_vlm_search = vlm_search;
+        generic_vlm_search.shallow_solver = false;
+
+        VLMAnalyzer shallow_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMAnalyzer generic_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMResult generic_result;
+
+        MovePosition terminating_move;
+
+        if(shallow_analyzer.TerminateCheck(&terminating_move)){
+          continue;
+        }
+
+        // root nodeでは専用ルーチンを使わないため直接呼び出す
+        const auto hash_value = CalcHashValue(board_move_sequence);
+        const auto shallow_value = is_black_turn ? shallow_analyzer.SolveShallowOR<kBlackTurn>(vlm_search, hash_value) : shallow_analyzer.SolveShallowOR<kWhiteTurn>(vlm_search, hash_value);
+        const auto generic_value = generic_analyzer.SolveOR(is_black_turn, generic_vlm_search, &generic_result);
+        ASSERT_EQ(generic_value, shallow_value) << board_move_sequence.str();
+
+        // 置換表への登録内容が一致する
+        VLMSearchValue shallow_table_value = 0, generic_table_value = 0;
+        ASSERT_TRUE(shallow_analyzer.FindSearchValue(vlm_search, hash_value, &shallow_table_value));
+        ASSERT_TRUE(generic_analyzer.FindSearchValue(generic_vlm_search, hash_value, &generic_table_value));
+        ASSERT_EQ(generic_table_value, shallow_table_value) << board_move_sequence.str();
+
+        if(IsVLMProved(shallow_value)){
+          // 置換表から証明木が取得できる
+          MoveTree proof_tree;
+          ASSERT_TRUE(shallow_analyzer.GetProofTree(&proof_tree)) << board_move_sequence.str();
+        }
+
+        // 再訪問では置換表に登録済の子ノードを指し手を設定せずに評価し、結果は変わらない
+        const auto revisit_value = is_black_turn ? shallow_analyzer.SolveShallowOR<kBlackTurn>(vlm_search, hash_value) : shallow_analyzer.SolveShallowOR<kWhiteTurn>(vlm_search, hash_value);
+        ASSERT_EQ(shallow_value, revisit_value) << board_move_sequence.str();
+      }
+
+      {
+        // 反復深化の残り深さ3の反復でもroot nodeの展開順序と強意の不詰の手が通常の探索と一致する
+        VLMSearch vlm_search;
+        vlm_search.remain_depth = 3;
+
+        VLMSearch generic_vlm_search = vlm_search;
+        generic_vlm_search.shallow_solver = false;
+
+        VLMAnalyzer shallow_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMAnalyzer generic_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMResult shallow_result, generic_result;
+
+        shallow_analyzer.Solve(vlm_search, &shallow_result);
+        generic_analyzer.Solve(generic_vlm_search, &generic_result);
+
+        ASSERT_EQ(generic_result.solved, shallow_result.solved) << board_move_sequence.str();
+        ASSERT_TRUE(generic_result.root_move_order == shallow_result.root_move_order) << board_move_sequence.str();
+        ASSERT_EQ(generic_result.refuted_root_move, shallow_result.refuted_root_move) << board_move_sequence.str();
+      }
+    }
   }
+  void ShallowORQuietPositionTest()
   {
-    constexpr VLMSearchValue value = kVLMWeakDisprovedLB;
-    ASSERT_EQ(225, GetVLMDepth(value));
+    {
+      // 四, 三を作る手がない局面: 残り深さ3の専用ルーチンでも強意の不詰にはならない
+      const MoveList move_list("hh");
+      const bool is_black_turn = false;
+
+      VLMSearch vlm_search;
+      vlm_search.remain_depth = 3;
+
+      VLMSearch generic_vlm_search = vlm_search;
+      generic_vlm_search.shallow_solver = false;
+
+      VLMAnalyzer shallow_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMAnalyzer generic_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMResult generic_result;
+
+      const auto shallow_value = shallow_analyzer.SolveShallowOR<kWhiteTurn>(vlm_search, CalcHashValue(move_list));
+      const auto generic_value = generic_analyzer.SolveOR(is_black_turn, generic_vlm_search, &generic_result);
+
+      ASSERT_TRUE(IsVLMWeakDisproved(shallow_value));
+      ASSERT_EQ(generic_value, shallow_value);
+
+      // 残り深さ3の結果を置換表に残したまま深い探索をしても反証にならない
+      vlm_search.remain_depth = 7;
+      VLMResult vlm_result;
+      shallow_analyzer.Solve(vlm_search, &vlm_result);
+
+      ASSERT_FALSE(vlm_result.solved);
+      ASSERT_FALSE(vlm_result.disproved);
+    }
+    {
+      // 四, 三を作る手がないランダム局面: 反復深化(残り深さ3の結果を引き継ぐ)の残り深さ5の結果が通常の探索と一致する
+      mt19937 random_engine(1);
+      constexpr size_t kPositionCount = 200;
+      constexpr size_t kMaxStoneCount = 16;
+
+      for(size_t position_index=0; position_index<kPositionCount; position_index++){
+        MoveList board_move_sequence;
+        GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+
+        VLMAnalyzer checker(board_move_sequence, vlm_table);
+        MovePosition guard_move;
+
+        if(checker.IsOpponentFour(&guard_move)){
+          continue;
+        }
+
+        MoveBitSet four_bit, three_bit;
+        const bool is_black_turn = board_move_sequence.size() % 2 == 0;
+
+        if(is_black_turn){
+          checker.EnumerateFourMoves<kBlackTurn>(&four_bit);
+          checker.EnumerateSemiThreeMoves<kBlackTurn>(&three_bit);
+        }else{
+          checker.EnumerateFourMoves<kWhiteTurn>(&four_bit);
+          checker.EnumerateSemiThreeMoves<kWhiteTurn>(&three_bit);
+        }
+
+        if((four_bit | three_bit).any()){
+          continue;
+        }
+
+        VLMSearch vlm_search;
+        vlm_search.remain_depth = 5;
+
+        VLMSearch generic_vlm_search = vlm_search;
+        generic_vlm_search.shallow_solver = false;
+
+        VLMAnalyzer shallow_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMAnalyzer generic_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMResult shallow_result, generic_result;
+
+        shallow_analyzer.Solve(vlm_search, &shallow_result);
+        generic_analyzer.Solve(generic_vlm_search, &generic_result);
+
+        ASSERT_EQ(generic_result.solved, shallow_result.solved) << board_move_sequence.str();
+        ASSERT_EQ(generic_result.disproved, shallow_result.disproved) << board_move_sequence.str();
+      }
+    }
   }
-}
 
-TEST_F(VLMAnalyzerTest, GetVLMProvedSearchValueTest)
-{
+  void DepthTwoGuardTest()
+  {
+    // ランダムに生成した局面の残り深さ2のAND nodeで、終端手防手の評価が通常の探索(SolveAND)と一致することを確認する
+    mt19937 random_engine(2);
+    constexpr size_t kPositionCount = 200;
+    constexpr size_t kMaxStoneCount = 24;
+    uint64_t probe_count = 0;
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+
+      const bool is_black_turn = board_move_sequence.size() % 2 == 0;
+
+      VLMSearch vlm_search;
+      vlm_search.remain_depth = 2;
+
+      VLMSearch generic_vlm_search = vlm_search;
+      generic_vlm_search.shallow_solver = false;
+
+      VLMAnalyzer shallow_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMAnalyzer generic_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult shallow_result, generic_result;
+
+      VLMSearchValue shallow_value = 0, generic_value = 0;
+
+      if(is_black_turn){
+        shallow_value = shallow_analyzer.SolveAND<kBlackTurn>(vlm_search, &shallow_result);
+        generic_value = generic_analyzer.SolveAND<kBlackTurn>(generic_vlm_search, &generic_result);
+      }else{
+        shallow_value = shallow_analyzer.SolveAND<kWhiteTurn>(vlm_search, &shallow_result);
+        generic_value = generic_analyzer.SolveAND<kWhiteTurn>(generic_vlm_search, &generic_result);
+      }
+
+      ASSERT_EQ(generic_value, shallow_value) << board_move_sequence.str();
+      ASSERT_EQ(0, generic_analyzer.GetDepthTwoProbeCount() + generic_analyzer.GetDepthTwoMoveCount());
+
+      // 同じ置換表で再評価しても結果は変わらない(AND node自体が登録済の場合は子ノードを評価しない)
+      const auto move_count = shallow_analyzer.GetDepthTwoMoveCount();
+      const auto revisit_value = is_black_turn ? shallow_analyzer.SolveAND<kBlackTurn>(vlm_search, &shallow_result) : shallow_analyzer.SolveAND<kWhiteTurn>(vlm_search, &shallow_result);
+
+      ASSERT_EQ(shallow_value, revisit_value) << board_move_sequence.str();
+      ASSERT_EQ(move_count, shallow_analyzer.GetDepthTwoMoveCount());
+      probe_count += shallow_analyzer.GetDepthTwoProbeCount();
+    }
+
+    {
+      // 反復深化で再訪問する防手は置換表のみで評価し、解図結果は通常の探索と一致する
+      MoveList move_list;    // 四三(LH)で詰む
+      VLMSearch vlm_search;
+      GetFourThreeProblem(&move_list, &vlm_search);
+
+      VLMSearch generic_vlm_search = vlm_search;
+      generic_vlm_search.shallow_solver = false;
+
+      VLMAnalyzer shallow_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMAnalyzer generic_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMResult shallow_result, generic_result;
+
+      shallow_analyzer.Solve(vlm_search, &shallow_result);
+      generic_analyzer.Solve(generic_vlm_search, &generic_result);
+
+      ASSERT_TRUE(shallow_result.solved);
+      ASSERT_EQ(generic_result.solved, shallow_result.solved);
+      ASSERT_EQ(generic_result.search_depth, shallow_result.search_depth);
+      ASSERT_LT(0, shallow_analyzer.GetDepthTwoMoveCount());
+      probe_count += shallow_analyzer.GetDepthTwoProbeCount();
+    }
+
+    ASSERT_LT(0, probe_count);
+  }
+
+  void DepthTwoCounterFourTest()
   {
+    // 白: 三(FD-GD-HD), 黒: 一端が止まった三(FJ-GJ-HJ)の局面で黒が防手を選ぶ
+    const MoveList move_list("fjfdgjgdhjhdooej");
+    const auto hash_value = CalcHashValue(move_list);
+
+    VLMSearch vlm_search;
+    vlm_search.remain_depth = 2;
+
+    VLMSearch child_vlm_search = vlm_search;
+    child_vlm_search.remain_depth--;
+
     constexpr VLMSearchDepth depth = 1;
-    ASSERT_EQ(kVLMProvedUB, GetVLMProvedSearchValue(depth));
+    constexpr auto weak_disproved_value = GetVLMWeakDisprovedSearchValue(depth);
+
+    {
+      // 四ノビとなる防手(IJ)は指し手を設定せずに評価し、通常の探索と同じ値を置換表に登録する
+      VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      MoveList guard_move;
+      guard_move += kMoveIJ;
+
+      const auto and_node_value = vlm_analyzer.SolveDepthTwoGuard<kBlackTurn>(vlm_search, hash_value, guard_move);
+      ASSERT_EQ(weak_disproved_value, and_node_value);
+      ASSERT_EQ(1, vlm_analyzer.GetDepthTwoProbeCount());
+      ASSERT_EQ(0, vlm_analyzer.GetDepthTwoMoveCount());
+
+      MoveList child_move_list(move_list);
+      child_move_list += kMoveIJ;
+
+      VLMAnalyzer generic_analyzer(child_move_list, make_shared<VLMTable>(0, kLockFree));
+      MovePosition terminating_move;
+      ASSERT_FALSE(generic_analyzer.TerminateCheck(&terminating_move));
+
+      VLMSearchValue table_value = 0;
+      ASSERT_TRUE(vlm_analyzer.FindSearchValue(child_vlm_search, CalcHashValue(child_move_list), generic_analyzer.bit_board_, &table_value));
+      ASSERT_EQ(weak_disproved_value, table_value);
+    }
+    {
+      // 四ノビにならない防手(ED)は指し手を設定して終端チェックを行う
+      VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      MoveList guard_move;
+      guard_move += kMoveED;
+
+      const auto and_node_value = vlm_analyzer.SolveDepthTwoGuard<kBlackTurn>(vlm_search, hash_value, guard_move);
+      ASSERT_EQ(weak_disproved_value, and_node_value);
+      ASSERT_EQ(0, vlm_analyzer.GetDepthTwoProbeCount());
+      ASSERT_EQ(1, vlm_analyzer.GetDepthTwoMoveCount());
+    }
   }
+
+  void RecordedProofTreeTest()
   {
-    constexpr VLMSearchDepth depth = 225;
-    ASSERT_EQ(kVLMProvedLB, GetVLMProvedSearchValue(depth));
+    // 探索中に記録した証明木が置換表によらず詰みを示すことを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+    vlm_search.relevance_zone_pruning = false;    // 枝刈りした防手は証明木に含まれないため
+    vlm_search.record_proof_tree = true;
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+
+    MoveTree proof_tree;
+    ASSERT_TRUE(vlm_analyzer.GetRecordedProofTree(&proof_tree));
+
+    // 記録を用いずに置換表から取得した証明木と同じ深さの詰みを示す
+    VLMSearch table_search = vlm_search;
+    table_search.record_proof_tree = false;
+
+    VLMAnalyzer table_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult table_result;
+    table_analyzer.Solve(table_search, &table_result);
+    ASSERT_TRUE(table_result.solved);
+    ASSERT_EQ(table_result.search_depth, vlm_result.search_depth);
+
+    MoveTree table_proof_tree;
+    ASSERT_TRUE(table_analyzer.GetProofTree(&table_proof_tree));
+    ASSERT_TRUE(table_analyzer.or_proof_record_.empty());
+
+    // 探索を行わずに盤面上で手順を再生して検証する
+    const VLMProofVerifier proof_verifier(move_list);
+    ASSERT_TRUE(proof_verifier.Verify(table_proof_tree, 1));
+    ASSERT_TRUE(proof_verifier.Verify(proof_tree, 1));
+    ASSERT_TRUE(proof_verifier.Verify(vlm_result.proof_tree, 1));
+
+    // 置換表を参照せずに証明木を走査して詰みを確認する
+    VLMAnalyzer scan_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMSearch scan_search;
+    scan_search.is_search = false;
+    scan_search.detect_dual_solution = false;
+    scan_search.remain_depth = vlm_result.search_depth;
+
+    const auto search_value = scan_analyzer.SimulationOR<kBlackTurn>(scan_search, VLMAnalyzer::kScanProofTree, &proof_tree);
+    ASSERT_TRUE(IsVLMProved(search_value));
   }
-}
 
-TEST_F(VLMAnalyzerTest, GetVLMWeakDisprovedSearchValueTest)
-{
+  void ForbiddenMoveCacheTest()
   {
-    constexpr VLMSearchDepth depth = 1;
-    ASSERT_EQ(kVLMWeakDisprovedUB, GetVLMWeakDisprovedSearchValue(depth));
+    // 手数ごとにキャッシュした禁手がEnumerateForbiddenMovesと一致することを確認する
+    const MoveList move_list("hhhgihigjhaafgabffbalgbblfgh");
+    VLMAnalyzer vlm_analyzer(move_list, vlm_table);
+
+    const auto check_forbidden_bit = [&vlm_analyzer](){
+      MoveBitSet cached_bit, forbidden_bit;
+      vlm_analyzer.GetForbiddenMoveBit(&cached_bit);
+      vlm_analyzer.EnumerateForbiddenMoves(&forbidden_bit);
+      ASSERT_EQ(forbidden_bit, cached_bit);
+    };
+
+    check_forbidden_bit();
+
+    vlm_analyzer.MakeMove(kMoveLH);
+    check_forbidden_bit();
+
+    vlm_analyzer.MakeMove(kNullMove);   // Passは直前の局面の禁手を引き継ぐ
+    check_forbidden_bit();
+
+    vlm_analyzer.UndoMove();
+    vlm_analyzer.UndoMove();
+    check_forbidden_bit();
+
+    vlm_analyzer.MakeMove(kMoveLI);     // 別の指し手では手数1のキャッシュを再計算する
+    check_forbidden_bit();
+    vlm_analyzer.UndoMove();
   }
+
+  void VCFTableShareTest()
   {
-    constexpr VLMSearchDepth depth = 225;
-    ASSERT_EQ(kVLMWeakDisprovedLB, GetVLMWeakDisprovedSearchValue(depth));
+    // 局面ごとに生成したVLMAnalyzerでVCF探索用置換表を共有しても、VCF探索用置換表を指定しない場合と解図結果が一致することを確認する
+    const auto vcf_table = make_shared<VCFTable>(kDefaultVCFTableSpace, kLockFree);
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 50;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+
+    vector<MoveList> board_move_sequence_list(1, four_three_sequence);
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer shared_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree), vcf_table);
+      ASSERT_EQ(vcf_table, shared_analyzer.vcf_table_);
+
+      VLMAnalyzer private_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      ASSERT_NE(vcf_table, private_analyzer.vcf_table_);
+
+      VLMResult shared_result, private_result;
+      shared_analyzer.Solve(vlm_search, &shared_result);
+      private_analyzer.Solve(vlm_search, &private_result);
+
+      ASSERT_EQ(private_result.solved, shared_result.solved) << board_move_sequence.str();
+      ASSERT_EQ(private_result.disproved, shared_result.disproved) << board_move_sequence.str();
+      ASSERT_EQ(private_result.search_depth, shared_result.search_depth) << board_move_sequence.str();
+    }
   }
-}
 
-TEST_F(VLMAnalyzerTest, TranspositionTableTest)
-{
-  constexpr size_t table_space = 1;
-  VLMTable vlm_table(table_space, kLockFree);
+  //! @brief 優先度表を導入する前の順序付け(doc/02_performance/vlm_analyzer_performance.pptx, 「OR nodeの指し手」)で指し手を生成する
+  template<PlayerTurn P>
+  void HandTunedMoveOrderingOR(const VLMAnalyzer &vlm_analyzer, const VLMSearchDepth remain_depth, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move)
+  {
+    MoveBitSet four_bit, three_bit, double_three_bit, mise_bit, multi_mise_bit, sword_bit, two_bit;
+    vlm_analyzer.EnumerateFourMoves<P>(&four_bit);
+    vlm_analyzer.EnumerateSemiThreeMoves<P>(&three_bit);
+    vlm_analyzer.EnumerateDoubleSemiThreeMoves<P>(&double_three_bit);
+    vlm_analyzer.EnumeratePointOfSwordMoves<P>(&sword_bit);
 
-  static_assert(kUseExactBoardInfo == 1, "This test assumes kUseExactBoardInfo == 1");
+    if(remain_depth >= 3){
+      SelectMove(four_bit & three_bit, candidate_move_bit, candidate_move);
 
-  // Hash値は等しいが盤面情報が異なるケースのテスト
-  constexpr HashValue hash_value = 0;
-  BitBoard bit_board_1, bit_board_2;
-  constexpr VLMSearchValue search_value = 1;
+      if(P == kWhiteTurn){
+        SelectMove(double_three_bit, candidate_move_bit, candidate_move);
+        SelectMove((four_bit | three_bit) & sword_bit, candidate_move_bit, candidate_move);
+      }
+    }
 
-  bit_board_1.SetState<kBlackStone>(kMoveHH);
-  bit_board_2.SetState<kBlackStone>(kMoveHG);
+    if(remain_depth >= 5){
+      vlm_analyzer.EnumerateMiseMoves<P>(&mise_bit, &multi_mise_bit);
+      vlm_analyzer.EnumerateTwoMoves<P>(&two_bit);
 
-  vlm_table.Upsert(hash_value, bit_board_1, search_value);
+      SelectMove((four_bit | three_bit) & mise_bit, candidate_move_bit, candidate_move);
+      SelectMove(multi_mise_bit, candidate_move_bit, candidate_move);
+
+      if(P == kWhiteTurn){
+        SelectMove(mise_bit & sword_bit, candidate_move_bit, candidate_move);
+      }
+
+      SelectMove(sword_bit, candidate_move_bit, candidate_move);
+      SelectMove(two_bit, candidate_move_bit, candidate_move);
+    }
 
+    SelectMove(four_bit, candidate_move_bit, candidate_move);
+    SelectMove(three_bit, candidate_move_bit, candidate_move);
+    GetMoveList(*candidate_move_bit, candidate_move);
+  }
+
+  //! @brief 優先度表を導入する前のAND nodeの順序付け(三を作る手, 相手の四ノビ点の順)で指し手を生成する
+  template<PlayerTurn P>
+  void HandTunedMoveOrderingAND(const VLMAnalyzer &vlm_analyzer, MoveBitSet * const candidate_move_bit, MoveList * const candidate_move)
   {
-    VLMSearchValue table_value = 0;
-    const auto find_result = vlm_table.find(hash_value, bit_board_1, &table_value);
-    ASSERT_TRUE(find_result);
-    ASSERT_EQ(search_value, table_value);
+    constexpr PlayerTurn Q = GetOpponentTurn(P);
+
+    MoveBitSet three_bit, opponent_four_bit;
+    vlm_analyzer.EnumerateSemiThreeMoves<P>(&three_bit);
+    vlm_analyzer.EnumerateFourMoves<Q>(&opponent_four_bit);
+
+    SelectMove(three_bit, candidate_move_bit, candidate_move);
+    SelectMove(opponent_four_bit, candidate_move_bit, candidate_move);
+    GetMoveList(*candidate_move_bit, candidate_move);
   }
+
+  template<PlayerTurn P>
+  void CheckMoveOrderingTable(const VLMAnalyzer &vlm_analyzer, const MoveList &board_move_sequence)
   {
-    VLMSearchValue table_value = 0;
-    const auto find_result = vlm_table.find(hash_value, bit_board_2, &table_value);
-    ASSERT_FALSE(find_result);
+    MoveBitSet forbidden_bit, open_bit;
+    vlm_analyzer.GetForbiddenMoveBit(&forbidden_bit);
+    board_move_sequence.GetOpenMove(forbidden_bit, &open_bit);
+
+    for(const VLMSearchDepth remain_depth : {1, 3, 5, 7}){
+      VLMSearch vlm_search;
+      vlm_search.remain_depth = remain_depth;
+
+      {
+        MoveBitSet table_bit = open_bit, hand_tuned_bit = open_bit;
+        MoveList table_move, hand_tuned_move;
+
+        vlm_analyzer.MoveOrderingOR<P>(vlm_search, &table_bit, &table_move);
+        HandTunedMoveOrderingOR<P>(vlm_analyzer, remain_depth, &hand_tuned_bit, &hand_tuned_move);
+        ASSERT_EQ(hand_tuned_move.str(), table_move.str()) << board_move_sequence.str() << " depth: " << remain_depth;
+      }
+      {
+        MoveBitSet table_bit = open_bit, hand_tuned_bit = open_bit;
+        MoveList table_move, hand_tuned_move;
+
+        vlm_analyzer.MoveOrderingAND<P>(vlm_search, &table_bit, &table_move);
+        HandTunedMoveOrderingAND<P>(vlm_analyzer, &hand_tuned_bit, &hand_tuned_move);
+        ASSERT_EQ(hand_tuned_move.str(), table_move.str()) << board_move_sequence.str() << " depth: " << remain_depth;
+      }
+    }
   }
-}
 
-TEST_F(VLMAnalyzerTest, GetSearchValueTest)
-{
-  GetSearchValueTest();
-}
+  void MoveOrderingTableTest()
+  {
+    // 既定の優先度表による順序付けが優先度表を導入する前の順序付けと一致することを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 100;
+    constexpr size_t kMaxStoneCount = 24;
 
-TEST_F(VLMAnalyzerTest, SimulationTest)
-{
-  SimulationTest();
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+
+      VLMAnalyzer vlm_analyzer(board_move_sequence, vlm_table);
+      MovePosition guard_move;
+
+      if(vlm_analyzer.IsOpponentFour(&guard_move)){
+        // 相手に四がある局面は順序付けを行わない
+        continue;
+      }
+
+      if(board_move_sequence.IsBlackTurn()){
+        CheckMoveOrderingTable<kBlackTurn>(vlm_analyzer, board_move_sequence);
+      }else{
+        CheckMoveOrderingTable<kWhiteTurn>(vlm_analyzer, board_move_sequence);
+      }
+    }
+  }
+
+  void MoveOrderingStatTest()
+  {
+    // 順序付けの区分の実績に選択したすべての手が加算されることを確認する
+    MoveList move_list;
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+
+    VLMAnalyzer vlm_analyzer(move_list, vlm_table);
+
+    MoveList candidate_move;
+    vlm_analyzer.GetCandidateMoveOR<kBlackTurn>(vlm_search, &candidate_move);
+
+    MoveBitSet candidate_move_bit, four_bit, three_bit;
+
+    for(const auto move : candidate_move){
+      candidate_move_bit.set(move);
+    }
+
+    vlm_analyzer.EnumerateFourMoves<kBlackTurn>(&four_bit);
+    vlm_analyzer.EnumerateSemiThreeMoves<kBlackTurn>(&three_bit);
+
+    // 四ノビ, 三を作る手をすべて選択した手とする
+    const MoveBitSet selected_move_bit = (four_bit | three_bit) & candidate_move_bit;
+    ASSERT_GE(selected_move_bit.count(), 2);
+
+    vlm_analyzer.UpdateMoveOrderingStat<kBlackTurn>(kOrderingORBlack, vlm_search, candidate_move, selected_move_bit);
+    const auto &stat_table = vlm_analyzer.GetMoveOrderingStat(kOrderingORBlack);
+
+    ASSERT_EQ((four_bit & candidate_move_bit).count(), stat_table[kOrderingFour].candidate_count);
+    ASSERT_EQ((four_bit & candidate_move_bit).count(), stat_table[kOrderingFour].selected_count);
+    ASSERT_EQ((three_bit & candidate_move_bit).count(), stat_table[kOrderingThree].selected_count);
+    ASSERT_EQ((four_bit & three_bit & candidate_move_bit).count(), stat_table[kOrderingFourThree].selected_count);
+    ASSERT_EQ(0, stat_table[kOrderingOpponentFour].selected_count);
+  }
+
+  void SummarizedProofTreeMemoTest()
+  {
+    // 集約した証明木のメモは(Hash値, 詰みの深さ)で区別し、詰みの深さが異なる同一局面のメモは用いないことを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+
+    vlm_analyzer.MakeMove(vlm_result.proof_tree.GetTopNodeMove());
+    const auto and_hash_value = CalcHashValue(vlm_analyzer.board_move_sequence_);
+    VLMSearchValue and_search_value = 0;
+    ASSERT_TRUE(vlm_analyzer.vlm_table_->find(and_hash_value, vlm_analyzer.bit_board_, &and_search_value));
+    ASSERT_TRUE(IsVLMProved(and_search_value));
+    vlm_analyzer.UndoMove();
+
+    // 詰みの深さが異なる局面として防手のないメモを登録する(Hash値のみで区別すると防手のない証明木になる)
+    vlm_analyzer.ClearSummarizedProofTreeMemo();
+    const auto memo_key = make_pair(and_hash_value, static_cast<VLMSearchDepth>(GetVLMDepth(and_search_value) + 2));
+    vlm_analyzer.summarized_and_memo_.insert(make_pair(memo_key, MoveList()));
+
+    MoveTree proof_tree;
+    ASSERT_TRUE(vlm_analyzer.GetProofTreeOR<kBlackTurn>(&proof_tree, VLMAnalyzer::kGenerateSummarizedTree));
+    vlm_analyzer.ClearSummarizedProofTreeMemo();
+
+    const VLMProofVerifier proof_verifier(move_list);
+    ASSERT_TRUE(proof_verifier.Verify(proof_tree, 1));
+  }
+
+  void DualSolutionThreadTest()
+  {
+    // 余詰判定で詰む手の証明木を並行して取得しても逐次取得した場合と余詰, 最善応手が一致することを確認する
+    // 並行取得ではthreadごとにVCF探索用置換表を確保するため、ロック制御を行わないVCF探索用置換表を指定しても共有しない
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 20;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+    vlm_search.detect_dual_solution = true;
+
+    vector<MoveList> board_move_sequence_list(1, four_three_sequence);
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      // 最短手順モードでも並行取得したthreadの証明木が逐次取得と一致する
+      for(const bool shortest_solution : {false, true}){
+        VLMSearch serial_search = vlm_search;
+        serial_search.shortest_solution = shortest_solution;
+
+        VLMSearch thread_search = serial_search;
+        thread_search.dual_solution_thread = 4;
+
+        VLMAnalyzer serial_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+        VLMAnalyzer thread_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockControl), make_shared<VCFTable>(kDefaultVCFTableSpace, kLockFree));
+        VLMResult serial_result, thread_result;
+
+        serial_analyzer.Solve(serial_search, &serial_result);
+        thread_analyzer.Solve(thread_search, &thread_result);
+
+        ASSERT_EQ(serial_result.solved, thread_result.solved) << board_move_sequence.str();
+        ASSERT_EQ(serial_result.proof_tree.str(), thread_result.proof_tree.str()) << board_move_sequence.str();
+        ASSERT_EQ(serial_result.detect_dual_solution, thread_result.detect_dual_solution) << board_move_sequence.str();
+        ASSERT_EQ(serial_result.dual_solution_tree.str(), thread_result.dual_solution_tree.str()) << board_move_sequence.str();
+        ASSERT_EQ(serial_result.best_response.str(), thread_result.best_response.str()) << board_move_sequence.str();
+      }
+    }
+  }
+
+  //! @brief 証明木の各OR nodeの詰みが最短であることを確認する(2手短い深さでは詰まない)
+  //! @param board_sequence 現在のnodeの局面
+  //! @param is_or_node 現在のnodeがOR nodeか
+  //! @param proof_tree 証明木(現在のnode以下を確認する)
+  //! @param tree_depth 現在のnode以下の証明木の深さ
+  void CheckShortestProofTree(const MoveList &board_sequence, const bool is_or_node, MoveTree * const proof_tree, size_t * const tree_depth)
+  {
+    assert(proof_tree != nullptr);
+    assert(tree_depth != nullptr);
+
+    MoveList child_move_list;
+    proof_tree->GetChildMoveList(&child_move_list);
+    *tree_depth = 0;
+
+    for(const auto move : child_move_list){
+      MoveList child_sequence = board_sequence;
+      child_sequence += move;
+
+      proof_tree->MoveChildNode(move);
+      size_t child_depth = 0;
+      CheckShortestProofTree(child_sequence, !is_or_node, proof_tree, &child_depth);
+      proof_tree->MoveParent();
+
+      *tree_depth = max(*tree_depth, child_depth + 1);
+    }
+
+    if(!is_or_node || *tree_depth < 3){
+      return;
+    }
+
+    VLMSearch vlm_search;
+    vlm_search.remain_depth = static_cast<VLMSearchDepth>(*tree_depth - 2);
+    vlm_search.detect_dual_solution = false;
+
+    VLMAnalyzer vlm_analyzer(board_sequence, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_FALSE(vlm_result.solved) << board_sequence.str();
+  }
+
+  void SlicedSolverTest()
+  {
+    // coroutineがthisを保持するため、複製・移動はできない
+    static_assert(!is_copy_constructible<VLMSlicedSolver>::value, "VLMSlicedSolver must not be copyable");
+    static_assert(!is_move_constructible<VLMSlicedSolver>::value, "VLMSlicedSolver must not be movable");
+
+    // 中断・再開しながら解図した結果が通常の解図結果と一致することを確認する(詰む局面, 強意の不詰の局面)
+    for(const bool is_proved_problem : {true, false}){
+      MoveList move_list;
+      VLMSearch vlm_search;
+
+      if(is_proved_problem){
+        GetFourThreeProblem(&move_list, &vlm_search);
+      }else{
+        GetDoubleThreeProblem(&move_list, &vlm_search);
+      }
+
+      vlm_search.detect_dual_solution = true;   // 余詰探索も中断・再開する
+
+      VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+      ASSERT_EQ(is_proved_problem, vlm_result.solved);
+      ASSERT_EQ(!is_proved_problem, vlm_result.disproved);
+
+      VLMSlicedSolver sliced_solver(move_list, make_shared<VLMTable>(0, kLockFree), vlm_search);
+      constexpr uint64_t node_quantum = 1;
+      size_t run_count = 0;
+
+      while(!sliced_solver.Run(node_quantum)){
+        run_count++;
+      }
+
+      if(is_proved_problem){
+        ASSERT_GT(run_count, 0);
+      }
+
+      ASSERT_TRUE(sliced_solver.IsFinished());
+
+      const auto &sliced_result = sliced_solver.GetResult();
+      ASSERT_EQ(vlm_result.solved, sliced_result.solved);
+      ASSERT_EQ(vlm_result.disproved, sliced_result.disproved);
+      ASSERT_EQ(vlm_result.search_depth, sliced_result.search_depth);
+      ASSERT_EQ(vlm_result.proof_tree.str(), sliced_result.proof_tree.str());
+      ASSERT_EQ(vlm_result.detect_dual_solution, sliced_result.detect_dual_solution);
+      ASSERT_EQ(vlm_analyzer.GetSearchManager().GetNode(), sliced_solver.GetAnalyzer().GetSearchManager().GetNode());
+    }
+  }
+
+  void ResumeSolveTest()
+  {
+    // 探索ノード数の上限で中断した解図を継続した結果が中断しない解図結果と一致することを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+    vlm_search.detect_dual_solution = true;   // 余詰の有無も中断しない解図結果と一致する
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+
+    VLMSearch budget_search = vlm_search;
+    budget_search.node_limit = 16;
+
+    VLMAnalyzer resume_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult resume_result;
+    resume_analyzer.Solve(budget_search, &resume_result);
+    ASSERT_TRUE(resume_result.budget_exhausted);
+    ASSERT_LT(resume_result.search_depth, vlm_result.search_depth);
+
+    resume_analyzer.ResumeSolve(vlm_search, &resume_result);
+    ASSERT_TRUE(resume_result.solved);
+    ASSERT_FALSE(resume_result.budget_exhausted);
+    ASSERT_EQ(vlm_result.search_depth, resume_result.search_depth);
+    ASSERT_EQ(vlm_result.detect_dual_solution, resume_result.detect_dual_solution);
+
+    const VLMProofVerifier proof_verifier(move_list);
+    ASSERT_TRUE(proof_verifier.Verify(resume_result.proof_tree, 1));
+
+    // Solveは前回の解図結果のroot nodeの情報を引き継がない(すべての候補手を反証済とした結果を渡しても詰む)
+    VLMResult stale_result = vlm_result;
+    stale_result.solved = false;
+    stale_result.refuted_root_move.set();
+    stale_result.root_move_order.clear();
+
+    VLMAnalyzer stale_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    stale_analyzer.Solve(vlm_search, &stale_result);
+    ASSERT_TRUE(stale_result.solved);
+    ASSERT_EQ(vlm_result.search_depth, stale_result.search_depth);
+    ASSERT_EQ(vlm_result.proof_tree.str(), stale_result.proof_tree.str());
+  }
+
+  void SearchBudgetTest()
+  {
+    // 中断した深さは探索済の深さに含めない(深さ1で中断した場合は0)
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+    vlm_search.node_limit = 1;
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+    ASSERT_FALSE(vlm_result.solved);
+    ASSERT_FALSE(vlm_result.disproved);
+    ASSERT_TRUE(vlm_result.budget_exhausted);
+    ASSERT_EQ(0, vlm_result.search_depth);
+
+    // 上限のない解図は中断しない
+    vlm_search.node_limit = 0;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+    ASSERT_TRUE(vlm_result.solved);
+    ASSERT_FALSE(vlm_result.budget_exhausted);
+  }
+
+  void ForcedMoveExtensionTest()
+  {
+    // 四の防手を続けて展開しても解図結果が変わらず、証明木が詰みを示し、探索ノード数が減ることを確認する
+    //   四三(LH)の局面はroot nodeの子ノードのみで詰むため、四ノビを含むランダムな局面でノード数を比較する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 50;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+    vlm_search.forced_move_extension = false;
+
+    VLMSearch forced_search = vlm_search;
+    forced_search.forced_move_extension = true;
+
+    vector<MoveList> board_move_sequence_list(1, four_three_sequence);
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    uint64_t node_count = 0, forced_node_count = 0;
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer vlm_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+      VLMAnalyzer forced_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult forced_result;
+      forced_analyzer.Solve(forced_search, &forced_result);
+
+      ASSERT_EQ(vlm_result.solved, forced_result.solved) << board_move_sequence.str();
+      ASSERT_EQ(vlm_result.disproved, forced_result.disproved) << board_move_sequence.str();
+      ASSERT_EQ(vlm_result.search_depth, forced_result.search_depth) << board_move_sequence.str();
+
+      if(forced_result.solved){
+        const VLMProofVerifier proof_verifier(board_move_sequence);
+        ASSERT_TRUE(proof_verifier.Verify(forced_result.proof_tree, 1)) << board_move_sequence.str();
+      }
+
+      node_count += vlm_analyzer.GetSearchManager().GetNode();
+      forced_node_count += forced_analyzer.GetSearchManager().GetNode();
+    }
+
+    ASSERT_LT(forced_node_count, node_count);
+  }
+
+  void VCFPrecheckTest()
+  {
+    // VCFの事前チェックを行っても解図結果が変わらず、証明木が詰みを示すことを確認する
+    mt19937 random_engine(3);
+    constexpr size_t kPositionCount = 50;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+    vlm_search.vcf_precheck = false;
+
+    VLMSearch vcf_search = vlm_search;
+    vcf_search.vcf_precheck = true;
+
+    vector<MoveList> board_move_sequence_list(1, four_three_sequence);
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer vlm_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+      VLMAnalyzer vcf_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vcf_result;
+      vcf_analyzer.Solve(vcf_search, &vcf_result);
+
+      ASSERT_EQ(vlm_result.solved, vcf_result.solved) << board_move_sequence.str();
+      ASSERT_EQ(vlm_result.disproved, vcf_result.disproved) << board_move_sequence.str();
+      ASSERT_EQ(vlm_result.search_depth, vcf_result.search_depth) << board_move_sequence.str();
+
+      if(vcf_result.solved){
+        const VLMProofVerifier proof_verifier(board_move_sequence);
+        ASSERT_TRUE(proof_verifier.Verify(vcf_result.proof_tree, 1)) << board_move_sequence.str();
+      }else if(!vcf_result.disproved){
+        // root nodeは通常探索するため、次の反復の展開順序は事前チェックの有無によらず設定される
+        ASSERT_EQ(vlm_result.root_move_order.empty(), vcf_result.root_move_order.empty()) << board_move_sequence.str();
+      }
+    }
+  }
+
+  void ProofVerifierTest()
+  {
+    // 解図結果の証明木は検証に成功し、防手の変化を欠いた証明木は検証に失敗することを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+
+    const VLMProofVerifier proof_verifier(move_list);
+    ASSERT_TRUE(proof_verifier.Verify(vlm_result.proof_tree, 1));
+    ASSERT_TRUE(proof_verifier.Verify(vlm_result.proof_tree, 4));
+
+    MoveTree first_move_tree;
+    first_move_tree.AddChild(vlm_result.proof_tree.GetTopNodeMove());
+    ASSERT_FALSE(proof_verifier.Verify(first_move_tree, 1));
+  }
+
+  void DisproofCertificateTest()
+  {
+    // 詰む局面では不詰の証明書を取得できず、防手のない証明書は検証に失敗することを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+    vlm_search.disproof_certificate = true;
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+    ASSERT_TRUE(vlm_result.disproof_certificate.empty());
+
+    string certificate;
+    ASSERT_FALSE(vlm_analyzer.GetDisproofCertificate(&certificate));
+
+    // ヘッダのみの証明書
+    string header_only(kDisproofCertificateMagic);
+    header_only += static_cast<char>(kDisproofCertificateVersion);
+    header_only += static_cast<char>(move_list.size());
+
+    for(const auto move : move_list){
+      header_only += static_cast<char>(move);
+    }
+
+    const VLMProofVerifier proof_verifier(move_list);
+    ASSERT_FALSE(proof_verifier.VerifyDisproofCertificate(header_only));
+    ASSERT_FALSE(proof_verifier.VerifyDisproofCertificate(""));
+  }
+
+  void DisproofCertificateRoundTripTest()
+  {
+    // 強意の不詰の局面で取得した証明書が検証に成功し、候補手(空点)ごとには記録しないことを確認する
+    MoveList move_list;
+    VLMSearch vlm_search;
+    GetDoubleThreeProblem(&move_list, &vlm_search);
+    vlm_search.disproof_certificate = true;
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.disproved);
+    ASSERT_FALSE(vlm_result.disproof_certificate.empty());
+
+    const VLMProofVerifier proof_verifier(move_list);
+    const string &certificate = vlm_result.disproof_certificate;
+    ASSERT_TRUE(proof_verifier.VerifyDisproofCertificate(certificate));
+
+    // 本体: 例外の候補手なし, 既定のAND node(終端)のみ
+    const size_t header_size = string(kDisproofCertificateMagic).size() + 2 + move_list.size();
+    ASSERT_EQ(header_size + 3, certificate.size());
+    ASSERT_EQ(0, static_cast<uint8_t>(certificate[header_size]));
+    ASSERT_EQ(kDisproofDefaultTag, static_cast<uint8_t>(certificate[header_size + 1]));
+    ASSERT_EQ(kDisproofTerminalTag, static_cast<uint8_t>(certificate[header_size + 2]));
+
+    // 改変した証明書は検証に失敗する
+    ASSERT_FALSE(proof_verifier.VerifyDisproofCertificate(certificate.substr(0, certificate.size() - 1)));
+    ASSERT_FALSE(proof_verifier.VerifyDisproofCertificate(certificate + static_cast<char>(kDisproofTerminalTag)));
+
+    string no_default = certificate;
+    no_default[header_size + 1] = static_cast<char>(kDisproofNoDefaultTag);
+    ASSERT_FALSE(proof_verifier.VerifyDisproofCertificate(no_default.substr(0, header_size + 2)));
+
+    // 取得結果のメモは取得ごとに破棄するため、再取得しても同じ証明書となる
+    string regenerated_certificate;
+    ASSERT_TRUE(vlm_analyzer.GetDisproofCertificate(&regenerated_certificate));
+    ASSERT_EQ(certificate, regenerated_certificate);
+    ASSERT_TRUE(vlm_analyzer.disproof_and_memo_.empty());
+    ASSERT_GE(kDisproofCertificateNodeLimit, vlm_analyzer.disproof_certificate_node_);
+
+    // 展開した局面数が上限に達している場合は取得しない
+    string over_budget_certificate;
+    vlm_analyzer.disproof_certificate_node_ = kDisproofCertificateNodeLimit;
+    ASSERT_FALSE(vlm_analyzer.GetDisproofCertificateOR<kBlackTurn>(&over_budget_certificate));
+
+    // ランダムに生成した局面: 例外の候補手を含む証明書も検証に成功する
+    mt19937 random_engine(3);
+    size_t disproved_count = 0;
+
+    for(size_t position_index=0; position_index<200; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(24, &random_engine, &board_move_sequence);
+
+      VLMSearch random_search = vlm_search;
+      random_search.remain_depth = 5;
+
+      VLMAnalyzer random_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult random_result;
+      random_analyzer.Solve(random_search, &random_result);
+
+      if(!random_result.disproved || random_result.disproof_certificate.empty()){
+        continue;
+      }
+
+      const VLMProofVerifier random_verifier(board_move_sequence);
+      ASSERT_TRUE(random_verifier.VerifyDisproofCertificate(random_result.disproof_certificate)) << board_move_sequence.str();
+      disproved_count++;
+    }
+
+    ASSERT_LT(0, disproved_count);
+  }
+
+  void ShortestSolutionTest()
+  {
+    // 最短手順モードの詰み手数が通常の探索と一致し、最短であることが証明済となることを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult vlm_result;
+    vlm_analyzer.Solve(vlm_search, &vlm_result);
+    ASSERT_TRUE(vlm_result.solved);
+    ASSERT_FALSE(vlm_result.shortest_solution);
+
+    VLMSearch shortest_search = vlm_search;
+    shortest_search.shortest_solution = true;
+
+    VLMAnalyzer shortest_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult shortest_result;
+    shortest_analyzer.Solve(shortest_search, &shortest_result);
+    ASSERT_TRUE(shortest_result.solved);
+    ASSERT_TRUE(shortest_result.shortest_solution);
+    ASSERT_EQ(vlm_result.search_depth, shortest_result.search_depth);
+    ASSERT_EQ(vlm_result.proof_tree.depth(), shortest_result.proof_tree.depth());
+
+    // 探索中に記録した証明木も各OR nodeで最短の詰みとなる
+    shortest_search.record_proof_tree = true;
+
+    VLMAnalyzer recorded_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+    VLMResult recorded_result;
+    recorded_analyzer.Solve(shortest_search, &recorded_result);
+    ASSERT_TRUE(recorded_result.solved);
+    ASSERT_TRUE(recorded_result.shortest_solution);
+
+    for(auto *proof_tree : {&shortest_result.proof_tree, &recorded_result.proof_tree}){
+      proof_tree->MoveRootNode();
+      size_t tree_depth = 0;
+      CheckShortestProofTree(move_list, true, proof_tree, &tree_depth);
+      ASSERT_EQ(shortest_result.search_depth, tree_depth);
+    }
+  }
+
+  void ResultCacheTest()
+  {
+    // 保存した解図結果を対称な局面, 深い深さの要求で取得でき、ファイルを開き直しても取得できることを確認する
+    MoveList move_list;    // 四三(LH)で詰む
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&move_list, &vlm_search);
+
+    const string cache_path = "VLMResultCacheTest.vlmr";
+    remove(cache_path.c_str());
+
+    VLMResult vlm_result;
+
+    {
+      auto result_cache = make_shared<VLMResultCache>(cache_path, 64);
+      ASSERT_TRUE(result_cache->IsOpen());
+      ASSERT_FALSE(result_cache->Find(move_list, vlm_search, &vlm_result));
+
+      VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+      ASSERT_TRUE(vlm_result.solved);
+      ASSERT_FALSE(vlm_result.result_cached);
+
+      result_cache->Upsert(move_list, vlm_search, vlm_result);
+    }
+
+    MoveList symmetric_list;
+
+    for(const auto move : move_list){
+      symmetric_list += GetSymmetricMove(move, kHorizontalSymmetry);
+    }
+
+    auto result_cache = make_shared<VLMResultCache>(cache_path, 64);
+
+    VLMSearch deep_search = vlm_search;
+    deep_search.remain_depth = 9;
+
+    VLMResult symmetric_result;
+    ASSERT_TRUE(result_cache->Find(symmetric_list, deep_search, &symmetric_result));
+
+    ASSERT_TRUE(symmetric_result.solved);
+    ASSERT_TRUE(symmetric_result.result_cached);
+    ASSERT_EQ(vlm_result.search_depth, symmetric_result.search_depth);
+    ASSERT_EQ(GetSymmetricMove(vlm_result.proof_tree.GetTopNodeMove(), kHorizontalSymmetry), symmetric_result.proof_tree.GetTopNodeMove());
+    ASSERT_EQ(1, result_cache->GetHitCount());
+
+    const VLMProofVerifier proof_verifier(symmetric_list);
+    ASSERT_TRUE(proof_verifier.Verify(symmetric_result.proof_tree, 1));
+
+    {
+      // 詰みを示した深さ未満の要求には詰まないことを返す
+      VLMSearch shallow_search = vlm_search;
+      shallow_search.remain_depth = vlm_result.search_depth - 2;
+
+      VLMResult shallow_result;
+      ASSERT_TRUE(result_cache->Find(move_list, shallow_search, &shallow_result));
+      ASSERT_FALSE(shallow_result.solved);
+      ASSERT_FALSE(shallow_result.disproved);
+      ASSERT_EQ(shallow_search.remain_depth, shallow_result.search_depth);
+    }
+    {
+      // 強意の不詰は深さによらず取得できる
+      const MoveList disproved_list("hhhg");
+      VLMResult disproved_result;
+      disproved_result.disproved = true;
+      disproved_result.search_depth = 7;
+      result_cache->Upsert(disproved_list, vlm_search, disproved_result);
+
+      for(const VLMSearchDepth depth : {1, 3, 7, 9}){
+        VLMSearch disproved_search = vlm_search;
+        disproved_search.remain_depth = depth;
+
+        VLMResult cached_result;
+        ASSERT_TRUE(result_cache->Find(disproved_list, disproved_search, &cached_result));
+        ASSERT_TRUE(cached_result.disproved);
+        ASSERT_FALSE(cached_result.solved);
+      }
+    }
+    {
+      // 探索ノード数 or 探索時間の上限で中断した結果は保存しない
+      const MoveList exhausted_list("hhhi");
+      VLMResult exhausted_result;
+      exhausted_result.search_depth = 5;
+      exhausted_result.budget_exhausted = true;
+      result_cache->Upsert(exhausted_list, vlm_search, exhausted_result);
+
+      VLMResult cached_result;
+      ASSERT_FALSE(result_cache->Find(exhausted_list, vlm_search, &cached_result));
+    }
+    {
+      // 余詰判定済の詰みは余詰判定を行わない詰みで上書きしない
+      VLMSearch dual_search = vlm_search;
+      dual_search.detect_dual_solution = true;
+
+      VLMAnalyzer dual_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+      VLMResult dual_result;
+      dual_analyzer.Solve(dual_search, &dual_result);
+      ASSERT_TRUE(dual_result.solved);
+
+      result_cache->Upsert(move_list, dual_search, dual_result);
+      result_cache->Upsert(move_list, vlm_search, vlm_result);
+
+      VLMResult cached_result;
+      ASSERT_TRUE(result_cache->Find(move_list, dual_search, &cached_result));
+      ASSERT_EQ(dual_result.detect_dual_solution, cached_result.detect_dual_solution);
+      ASSERT_EQ(dual_result.best_response.str(), cached_result.best_response.str());
+
+      // 証明木が同一の最短手順の詰みは余詰判定の結果を引き継ぐ
+      VLMResult shortest_result = dual_result;
+      shortest_result.shortest_solution = true;
+      result_cache->Upsert(move_list, vlm_search, shortest_result);
+
+      VLMSearch dual_shortest_search = dual_search;
+      dual_shortest_search.shortest_solution = true;
+
+      VLMResult merged_result;
+      ASSERT_TRUE(result_cache->Find(move_list, dual_shortest_search, &merged_result));
+      ASSERT_TRUE(merged_result.shortest_solution);
+      ASSERT_EQ(dual_result.detect_dual_solution, merged_result.detect_dual_solution);
+      ASSERT_EQ(dual_result.best_response.str(), merged_result.best_response.str());
+      ASSERT_EQ(dual_result.proof_tree.str(), merged_result.proof_tree.str());
+    }
+
+    remove(cache_path.c_str());
+  }
+
+  void IterativeDeepeningReuseTest()
+  {
+    // 反復深化で子ノードの結果を引き継いでも、詰みの証明木と強意の不詰の証明書が検証に成功することを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 100;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence, double_three_sequence;
+    VLMSearch vlm_search;
+    GetDoubleThreeProblem(&double_three_sequence, &vlm_search);
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+    vlm_search.disproof_certificate = true;
+
+    vector<MoveList> board_move_sequence_list{four_three_sequence, double_three_sequence};
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    size_t solved_count = 0, disproved_count = 0;
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer vlm_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+      const VLMProofVerifier proof_verifier(board_move_sequence);
+
+      if(vlm_result.solved){
+        ASSERT_TRUE(proof_verifier.Verify(vlm_result.proof_tree, 1)) << board_move_sequence.str();
+        solved_count++;
+      }else if(vlm_result.disproved && !vlm_result.disproof_certificate.empty()){
+        ASSERT_TRUE(proof_verifier.VerifyDisproofCertificate(vlm_result.disproof_certificate)) << board_move_sequence.str();
+        disproved_count++;
+      }
+    }
+
+    ASSERT_LT(0, solved_count);
+    ASSERT_LT(0, disproved_count);
+  }
+
+  //! @brief 葉ノードごとに手順を取得し、OR nodeの指し手からHash値を求め直して終端局面の直前のHash値を取得する
+  void GetPreTerminateHashPerLeaf(const bool is_black_turn, MoveTree * const proof_tree, set<HashValue> * const pre_terminate_hash_set)
+  {
+    assert(proof_tree != nullptr);
+    assert(pre_terminate_hash_set != nullptr);
+
+    vector<MoveNodeIndex> leaf_index_list;
+    proof_tree->GetLeafNodeList(&leaf_index_list);
+
+    for(const auto leaf_index : leaf_index_list){
+      proof_tree->MoveNode(leaf_index);
+      proof_tree->MoveParent();
+
+      MoveList move_list;
+      proof_tree->GetMoveList(&move_list);
+
+      HashValue hash_value = 0;
+
+      for(size_t i=0, size=move_list.size(); i<size; i+=2){
+        hash_value = CalcHashValue(is_black_turn, move_list[i], hash_value);
+      }
+
+      pre_terminate_hash_set->insert(hash_value);
+    }
+
+    proof_tree->MoveRootNode();
+  }
+
+  void PreTerminateHashTest()
+  {
+    // 証明木を1回の深さ優先探索で走査して求めた終端局面の直前のHash値が、葉ノードごとに求めた値と一致することを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 100;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence;
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+
+    vector<MoveList> board_move_sequence_list(1, four_three_sequence);
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    size_t solved_count = 0;
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer vlm_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult vlm_result;
+      vlm_analyzer.Solve(vlm_search, &vlm_result);
+
+      if(!vlm_result.solved){
+        continue;
+      }
+
+      set<HashValue> pre_terminate_hash_set, per_leaf_hash_set;
+      vlm_analyzer.GetPreTerminateHash(&vlm_result.proof_tree, &pre_terminate_hash_set);
+      GetPreTerminateHashPerLeaf(board_move_sequence.IsBlackTurn(), &vlm_result.proof_tree, &per_leaf_hash_set);
+
+      ASSERT_FALSE(pre_terminate_hash_set.empty()) << board_move_sequence.str();
+      ASSERT_EQ(per_leaf_hash_set, pre_terminate_hash_set) << board_move_sequence.str();
+      solved_count++;
+    }
+
+    ASSERT_LT(0, solved_count);
+  }
+
+  void SimulationSkipCountTest()
+  {
+    // 効果がないと判定した区分では一定間隔で試行し、試行しなかった回数のみを省略した回数とすることを確認する
+    VLMAnalyzer vlm_analyzer(MoveList("hh"), vlm_table);
+    constexpr VLMSearchDepth remain_depth = 5;
+    constexpr size_t proof_tree_depth = 3;
+
+    // 成功しないSimulationの実績
+    for(uint64_t i=0; i<kSimulationSampleCount; i++){
+      vlm_analyzer.UpdateSimulationStat(remain_depth, proof_tree_depth, false, 10);
+    }
+
+    vlm_analyzer.UpdateSolveStat(remain_depth, 100);
+
+    constexpr uint64_t kCheckCount = 2 * kSimulationProbeInterval;
+    uint64_t skip_count = 0, probe_count = 0;
+
+    for(uint64_t i=0; i<kCheckCount; i++){
+      if(vlm_analyzer.IsSimulationEffective(remain_depth, proof_tree_depth, &skip_count)){
+        probe_count++;
+      }
+    }
+
+    ASSERT_EQ(2, probe_count);
+    ASSERT_EQ(kCheckCount - probe_count, skip_count);
+
+    // 実績が不足している区分は省略しない
+    uint64_t sampling_skip_count = 0;
+    ASSERT_TRUE(vlm_analyzer.IsSimulationEffective(remain_depth + 2, proof_tree_depth, &sampling_skip_count));
+    ASSERT_EQ(0, sampling_skip_count);
+
+    // 省略した回数は呼び出し元が指定したものにのみ加算する
+    ASSERT_EQ(0, vlm_analyzer.GetSimulationSkipCount());
+    ASSERT_EQ(0, vlm_analyzer.GetProofTreeSkipCount());
+  }
+
+  void RelevanceZonePruningTest()
+  {
+    // 影響領域外の防手を枝刈りしても、枝刈りしない場合と解図結果が一致することを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 50;
+    constexpr size_t kMaxStoneCount = 24;
+
+    MoveList four_three_sequence, double_three_sequence;
+    VLMSearch vlm_search;
+    GetFourThreeProblem(&four_three_sequence, &vlm_search);
+    GetDoubleThreeProblem(&double_three_sequence, &vlm_search);
+    vlm_search.relevance_zone_pruning = true;
+
+    VLMSearch generic_vlm_search = vlm_search;
+    generic_vlm_search.relevance_zone_pruning = false;
+
+    vector<MoveList> board_move_sequence_list{double_three_sequence, four_three_sequence};
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+      board_move_sequence_list.emplace_back(board_move_sequence);
+    }
+
+    uint64_t prune_count = 0;
+
+    for(const auto &board_move_sequence : board_move_sequence_list){
+      VLMAnalyzer pruning_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMAnalyzer generic_analyzer(board_move_sequence, make_shared<VLMTable>(0, kLockFree));
+      VLMResult pruning_result, generic_result;
+
+      pruning_analyzer.Solve(vlm_search, &pruning_result);
+      generic_analyzer.Solve(generic_vlm_search, &generic_result);
+
+      ASSERT_EQ(generic_result.solved, pruning_result.solved) << board_move_sequence.str();
+      ASSERT_EQ(generic_result.disproved, pruning_result.disproved) << board_move_sequence.str();
+      ASSERT_EQ(generic_result.search_depth, pruning_result.search_depth) << board_move_sequence.str();
+      ASSERT_EQ(0, generic_analyzer.GetRelevanceZonePruneCount());
+
+      if(board_move_sequence.str() == double_three_sequence.str()){
+        ASSERT_TRUE(pruning_result.disproved);
+      }
+
+      if(pruning_result.solved){
+        const VLMProofVerifier proof_verifier(board_move_sequence);
+        ASSERT_TRUE(proof_verifier.Verify(pruning_result.proof_tree, 1)) << board_move_sequence.str();
+      }
+
+      prune_count += pruning_analyzer.GetRelevanceZonePruneCount();
+    }
+
+    ASSERT_LT(0, prune_count);
+  }
+
+  template<PlayerTurn P>
+  void CheckMoveOrderingThreatAND(const VLMAnalyzer &vlm_analyzer, const MoveList &board_move_sequence)
+  {
+    MoveBitSet forbidden_bit, guard_move_bit;
+    vlm_analyzer.GetForbiddenMoveBit(&forbidden_bit);
+    board_move_sequence.GetPossibleMove(forbidden_bit, &guard_move_bit);
+
+    MoveBitSet candidate_move_bit = guard_move_bit;
+    MoveList candidate_move;
+    vlm_analyzer.MoveOrderingThreatAND<P>(&candidate_move_bit, &candidate_move);
+
+    // 候補手(空点 + Pass)をそれぞれ1回ずつ含む
+    ASSERT_EQ(guard_move_bit.count(), candidate_move.size()) << board_move_sequence.str();
+
+    MoveBitSet ordered_move_bit;
+
+    for(const auto move : candidate_move){
+      ASSERT_TRUE(guard_move_bit[move]) << board_move_sequence.str();
+      ASSERT_FALSE(ordered_move_bit[move]) << board_move_sequence.str();
+      ordered_move_bit.set(move);
+    }
+
+    ASSERT_EQ(guard_move_bit, ordered_move_bit) << board_move_sequence.str();
+    ASSERT_TRUE(candidate_move_bit.none());
+  }
+
+  void MoveOrderingThreatANDTest()
+  {
+    // 脅威の推定値による防手の順序付けが候補手の並べ替えとなることを確認する
+    mt19937 random_engine(0);
+    constexpr size_t kPositionCount = 100;
+    constexpr size_t kMaxStoneCount = 24;
+    size_t check_count = 0;
+
+    for(size_t position_index=0; position_index<kPositionCount; position_index++){
+      MoveList board_move_sequence;
+      GenerateRandomPosition(kMaxStoneCount, &random_engine, &board_move_sequence);
+
+      VLMAnalyzer vlm_analyzer(board_move_sequence, vlm_table);
+      MovePosition guard_move;
+
+      if(vlm_analyzer.IsOpponentFour(&guard_move)){
+        // 相手に四がある局面は順序付けを行わない
+        continue;
+      }
+
+      if(board_move_sequence.IsBlackTurn()){
+        CheckMoveOrderingThreatAND<kBlackTurn>(vlm_analyzer, board_move_sequence);
+      }else{
+        CheckMoveOrderingThreatAND<kWhiteTurn>(vlm_analyzer, board_move_sequence);
+      }
+
+      check_count++;
+    }
+
+    ASSERT_LT(0, check_count);
+  }
+
+  void RefutationStatTest()
+  {
+    // 詰みを防ぐ防手が見つかったAND nodeの数, 展開した防手の数, 探索ノード数を確認する
+    //   黒石1つの局面で白がPassしても、黒は残り深さ3で三, 四を作れないため先頭のPassで詰みを防ぐ
+    const MoveList move_list("hh");
+    VLMAnalyzer vlm_analyzer(move_list, make_shared<VLMTable>(0, kLockFree));
+
+    VLMSearch vlm_search;
+    vlm_search.remain_depth = 4;
+    vlm_search.detect_dual_solution = false;
+
+    VLMResult vlm_result;
+    const auto search_value = vlm_analyzer.SolveAND<kWhiteTurn>(vlm_search, &vlm_result);
+    ASSERT_FALSE(IsVLMProved(search_value));
+
+    ASSERT_EQ(1, vlm_analyzer.GetRefutationCount());
+    ASSERT_EQ(1, vlm_analyzer.GetRefutationMoveCount());
+
+    // AND node自身を除く探索ノード数
+    ASSERT_LT(0, vlm_analyzer.GetRefutationNode());
+    ASSERT_LT(vlm_analyzer.GetRefutationNode(), vlm_analyzer.GetSearchManager().GetNode());
+  }
+};
+
+TEST_F(VLMAnalyzerTest, MakeMoveUndoTest){
+  MakeMoveUndoTest();
+}
+
+TEST_F(VLMAnalyzerTest, GetCandidateMoveORTest){
+  GetCandidateMoveORTest();
+}
+
+TEST_F(VLMAnalyzerTest, GetCandidateMoveANDTest){
+  GetCandidateMoveANDTest();
+}
+
+TEST_F(VLMAnalyzerTest, IsVLMProvedTest){
+  ASSERT_FALSE(IsVLMProved(kVLMStrongDisproved));
+  ASSERT_FALSE(IsVLMProved(kVLMWeakDisprovedLB));
+  ASSERT_FALSE(IsVLMProved(kVLMWeakDisprovedUB));
+  ASSERT_TRUE( IsVLMProved(kVLMProvedLB));
+  ASSERT_TRUE( IsVLMProved(kVLMProvedUB));
+}
+
+TEST_F(VLMAnalyzerTest, IsVLMDisprovedTest){
+  ASSERT_TRUE( IsVLMDisproved(kVLMStrongDisproved));
+  ASSERT_FALSE(IsVLMDisproved(kVLMWeakDisprovedLB));
+  ASSERT_FALSE(IsVLMDisproved(kVLMWeakDisprovedUB));
+  ASSERT_FALSE(IsVLMDisproved(kVLMProvedLB));
+  ASSERT_FALSE(IsVLMDisproved(kVLMProvedUB));
+}
+
+TEST_F(VLMAnalyzerTest, IsVLMWeakDisprovedTest){
+  ASSERT_FALSE(IsVLMWeakDisproved(kVLMStrongDisproved));
+  ASSERT_TRUE( IsVLMWeakDisproved(kVLMWeakDisprovedLB));
+  ASSERT_TRUE( IsVLMWeakDisproved(kVLMWeakDisprovedUB));
+  ASSERT_FALSE(IsVLMWeakDisproved(kVLMProvedLB));
+  ASSERT_FALSE(IsVLMWeakDisproved(kVLMProvedUB));
+}
+
+TEST_F(VLMAnalyzerTest, GetVLMDepthTest){
+  {
+    constexpr VLMSearchValue value = kVLMProvedUB;
+    ASSERT_EQ(1, GetVLMDepth(value));
+  }
+  {
+    constexpr VLMSearchValue value = kVLMProvedLB;
+    ASSERT_EQ(225, GetVLMDepth(value));
+  }
+  {
+    constexpr VLMSearchValue value = kVLMWeakDisprovedUB;
+    ASSERT_EQ(1, GetVLMDepth(value));
+  }
+  {
+    constexpr VLMSearchValue value = kVLMWeakDisprovedLB;
+    ASSERT_EQ(225, GetVLMDepth(value));
+  }
+}
+
+TEST_F(VLMAnalyzerTest, GetVLMProvedSearchValueTest)
+{
+  {
+    constexpr VLMSearchDepth depth = 1;
+    ASSERT_EQ(kVLMProvedUB, GetVLMProvedSearchValue(depth));
+  }
+  {
+    constexpr VLMSearchDepth depth = 225;
+    ASSERT_EQ(kVLMProvedLB, GetVLMProvedSearchValue(depth));
+  }
+}
+
+TEST_F(VLMAnalyzerTest, GetVLMWeakDisprovedSearchValueTest)
+{
+  {
+    constexpr VLMSearchDepth depth = 1;
+    ASSERT_EQ(kVLMWeakDisprovedUB, GetVLMWeakDisprovedSearchValue(depth));
+  }
+  {
+    constexpr VLMSearchDepth depth = 225;
+    ASSERT_EQ(kVLMWeakDisprovedLB, GetVLMWeakDisprovedSearchValue(depth));
+  }
+}
+
+TEST_F(VLMAnalyzerTest, TranspositionTableTest)
+{
+  constexpr size_t table_space = 1;
+  VLMTable vlm_table(table_space, kLockFree);
+
+  static_assert(kUseExactBoardInfo == 1, "This test assumes kUseExactBoardInfo == 1");
+
+  // Hash値は等しいが盤面情報が異なるケースのテスト
+  constexpr HashValue hash_value = 0;
+  BitBoard bit_board_1, bit_board_2;
+  constexpr VLMSearchValue search_value = 1;
+
+  bit_board_1.SetState<kBlackStone>(kMoveHH);
+  bit_board_2.SetState<kBlackStone>(kMoveHG);
+
+  vlm_table.Upsert(hash_value, bit_board_1, search_value);
+
+  {
+    VLMSearchValue table_value = 0;
+    const auto find_result = vlm_table.find(hash_value, bit_board_1, &table_value);
+    ASSERT_TRUE(find_result);
+    ASSERT_EQ(search_value, table_value);
+  }
+  {
+    VLMSearchValue table_value = 0;
+    const auto find_result = vlm_table.find(hash_value, bit_board_2, &table_value);
+    ASSERT_FALSE(find_result);
+  }
+}
+
+TEST_F(VLMAnalyzerTest, TranspositionTableBoundTest)
+{
+  constexpr size_t table_space = 1;
+  VLMTable vlm_table(table_space, kLockFree);
+
+  // 詰みを登録しても詰まないことを確認済の深さが保持されることのテスト
+  constexpr HashValue hash_value = 0;
+  BitBoard bit_board;
+  bit_board.SetState<kBlackStone>(kMoveHH);
+
+  vlm_table.Upsert(hash_value, bit_board, GetVLMWeakDisprovedSearchValue(5));
+  vlm_table.Upsert(hash_value, bit_board, GetVLMProvedSearchValue(9));
+
+  VLMSearchValue table_value = 0;
+  int16_t disproved_depth = 0;
+  ASSERT_TRUE(vlm_table.find(hash_value, bit_board, &table_value, &disproved_depth));
+  ASSERT_EQ(GetVLMProvedSearchValue(9), table_value);
+  ASSERT_EQ(5, disproved_depth);
+
+  // 詰みの登録後に確認した不詰の深さで更新する
+  vlm_table.Upsert(hash_value, bit_board, GetVLMWeakDisprovedSearchValue(7));
+  ASSERT_TRUE(vlm_table.find(hash_value, bit_board, &table_value, &disproved_depth));
+  ASSERT_EQ(GetVLMProvedSearchValue(9), table_value);
+  ASSERT_EQ(7, disproved_depth);
+
+  // 弱意の不詰を浅い深さで登録し直しても、確認済の深い深さの不詰を返す
+  VLMTable weak_table(table_space, kLockFree);
+  weak_table.Upsert(hash_value, bit_board, GetVLMWeakDisprovedSearchValue(9));
+  weak_table.Upsert(hash_value, bit_board, GetVLMWeakDisprovedSearchValue(5));
+
+  ASSERT_TRUE(weak_table.find(hash_value, bit_board, &table_value, &disproved_depth));
+  ASSERT_EQ(GetVLMWeakDisprovedSearchValue(9), table_value);
+  ASSERT_EQ(9, disproved_depth);
+
+  // その後に登録した詰みにも確認済の深さを引き継ぐ
+  weak_table.Upsert(hash_value, bit_board, GetVLMProvedSearchValue(11));
+  ASSERT_TRUE(weak_table.find(hash_value, bit_board, &table_value, &disproved_depth));
+  ASSERT_EQ(GetVLMProvedSearchValue(11), table_value);
+  ASSERT_EQ(9, disproved_depth);
+}
+
+TEST_F(VLMAnalyzerTest, GetSearchValueTest)
+{
+  GetSearchValueTest();
+}
+
+TEST_F(VLMAnalyzerTest, SimulationTest)
+{
+  SimulationTest();
+}
+
+TEST_F(VLMAnalyzerTest, SolveShallowORTest)
+{
+  SolveShallowORTest();
+}
+
+TEST_F(VLMAnalyzerTest, DepthTwoGuardTest)
+{
+  DepthTwoGuardTest();
+}
+
+TEST_F(VLMAnalyzerTest, DepthTwoCounterFourTest)
+{
+  DepthTwoCounterFourTest();
+}
+
+TEST_F(VLMAnalyzerTest, ShallowORQuietPositionTest)
+{
+  ShallowORQuietPositionTest();
+}
+
+TEST_F(VLMAnalyzerTest, SlicedSolverTest)
+{
+  SlicedSolverTest();
+}
+
+TEST_F(VLMAnalyzerTest, ResumeSolveTest)
+{
+  ResumeSolveTest();
+}
+
+TEST_F(VLMAnalyzerTest, SearchBudgetTest)
+{
+  SearchBudgetTest();
+}
+
+TEST_F(VLMAnalyzerTest, RecordedProofTreeTest)
+{
+  RecordedProofTreeTest();
+}
+
+TEST_F(VLMAnalyzerTest, ForbiddenMoveCacheTest)
+{
+  ForbiddenMoveCacheTest();
+}
+
+TEST_F(VLMAnalyzerTest, VCFTableShareTest)
+{
+  VCFTableShareTest();
+}
+
+TEST_F(VLMAnalyzerTest, DualSolutionThreadTest)
+{
+  DualSolutionThreadTest();
+}
+
+TEST_F(VLMAnalyzerTest, SummarizedProofTreeMemoTest)
+{
+  SummarizedProofTreeMemoTest();
+}
+
+TEST_F(VLMAnalyzerTest, MoveOrderingTableTest)
+{
+  MoveOrderingTableTest();
+}
+
+TEST_F(VLMAnalyzerTest, MoveOrderingStatTest)
+{
+  MoveOrderingStatTest();
+}
+
+TEST_F(VLMAnalyzerTest, ForcedMoveExtensionTest)
+{
+  ForcedMoveExtensionTest();
+}
+
+TEST_F(VLMAnalyzerTest, VCFPrecheckTest)
+{
+  VCFPrecheckTest();
+}
+
+TEST_F(VLMAnalyzerTest, ProofVerifierTest)
+{
+  ProofVerifierTest();
+}
+
+TEST_F(VLMAnalyzerTest, DisproofCertificateTest)
+{
+  DisproofCertificateTest();
+}
+
+TEST_F(VLMAnalyzerTest, DisproofCertificateRoundTripTest)
+{
+  DisproofCertificateRoundTripTest();
+}
+
+TEST_F(VLMAnalyzerTest, ShortestSolutionTest)
+{
+  ShortestSolutionTest();
+}
+
+TEST_F(VLMAnalyzerTest, ResultCacheTest)
+{
+  ResultCacheTest();
+}
+
+TEST_F(VLMAnalyzerTest, IterativeDeepeningReuseTest)
+{
+  IterativeDeepeningReuseTest();
+}
+
+TEST_F(VLMAnalyzerTest, PreTerminateHashTest)
+{
+  PreTerminateHashTest();
+}
+
+TEST_F(VLMAnalyzerTest, SimulationSkipCountTest)
+{
+  SimulationSkipCountTest();
+}
+
+TEST_F(VLMAnalyzerTest, RelevanceZonePruningTest)
+{
+  RelevanceZonePruningTest();
+}
+
+TEST_F(VLMAnalyzerTest, MoveOrderingThreatANDTest)
+{
+  MoveOrderingThreatANDTest();
+}
+
+TEST_F(VLMAnalyzerTest, RefutationStatTest)
+{
+  RefutationStatTest();
+}
+
+TEST_F(VLMAnalyzerTest, ProgressJSONTest)
+{
+  // 問題IDはJSONの文字列値としてエスケープして出力する
+  VLMProgress progress;
+  progress.search_depth = 3;
+
+  const string json = GetVLMProgressJSON(progress, "a\"b\\c\n");
+  ASSERT_EQ(0, json.find("{\"id\":\"a\\\"b\\\\c\\u000a\","));
+  ASSERT_EQ(string::npos, GetVLMProgressJSON(progress, "").find("\"id\""));
+
+  // 置換表の使用率は空き要素への登録数から算出する
+  VLMTable table(1, kLockControl);
+  ASSERT_EQ(0, table.GetFillRate());
+
+  BitBoard bit_board;
+  bit_board.SetState<kBlackStone>(kMoveHH);
+  table.Upsert(0, bit_board, 1);
+  ASSERT_LT(0, table.GetFillRate());
+
+  table.Initialize();
+  ASSERT_EQ(0, table.GetFillRate());
 }
 }
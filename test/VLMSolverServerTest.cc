@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "VLMSolverServer.h"
+
+using namespace std;
+using namespace realcore;
+
+class VLMSolverServerTest
+: public ::testing::Test
+{
+public:
+  void ParseValidRequestTest()
+  {
+    VLMSearch default_search;
+    default_search.remain_depth = 7;
+    default_search.detect_dual_solution = false;
+
+    {
+      // すべての項目を指定した要求
+      const string request_line = "{\"id\":\"q1\",\"board\":\"hhhi\",\"depth\":5,\"dual\":true,\"node_limit\":100,\"time_limit\":1.5,\"progress\":1000}";
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_TRUE(VLMSolverServer::ParseRequest(request_line, default_search, &request, &error_message));
+      ASSERT_EQ("q1", request.id);
+      ASSERT_EQ(MoveList("hhhi").str(), request.board_sequence.str());
+      ASSERT_EQ(5, request.vlm_search.remain_depth);
+      ASSERT_TRUE(request.vlm_search.detect_dual_solution);
+      ASSERT_EQ(100, request.vlm_search.node_limit);
+      ASSERT_EQ(1500, request.vlm_search.time_limit);
+      ASSERT_TRUE(request.is_progress_output);
+      ASSERT_EQ(1000, request.progress_interval);
+    }
+    {
+      // 省略した項目は既定値となる(余詰探索は行わない)
+      const string request_line = "{\"board\":\"hh\"}";
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_TRUE(VLMSolverServer::ParseRequest(request_line, default_search, &request, &error_message));
+      ASSERT_TRUE(request.id.empty());
+      ASSERT_EQ(default_search.remain_depth, request.vlm_search.remain_depth);
+      ASSERT_FALSE(request.vlm_search.detect_dual_solution);
+      ASSERT_EQ(0, request.vlm_search.node_limit);
+      ASSERT_EQ(0, request.vlm_search.time_limit);
+      ASSERT_FALSE(request.is_progress_output);
+    }
+  }
+
+  void ParseInvalidRequestTest()
+  {
+    const VLMSearch default_search;
+
+    {
+      // 必須項目(board)がない: 要求IDはエラー応答に付与するため取得する
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_FALSE(VLMSolverServer::ParseRequest("{\"id\":\"q2\",\"depth\":7}", default_search, &request, &error_message));
+      ASSERT_EQ("q2", request.id);
+      ASSERT_EQ("board is required", error_message);
+    }
+    {
+      // JSONとして不正
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_FALSE(VLMSolverServer::ParseRequest("{\"id\":\"q3\",\"board\":", default_search, &request, &error_message));
+      ASSERT_EQ(0, error_message.find("invalid JSON"));
+    }
+    {
+      // 局面の形式が不正
+      for(const string board : {"hz", "hhh"}){
+        VLMSolverServer::SolveRequest request;
+        string error_message;
+
+        ASSERT_FALSE(VLMSolverServer::ParseRequest("{\"board\":\"" + board + "\"}", default_search, &request, &error_message));
+        ASSERT_EQ("board must be a [a-o] move string", error_message);
+      }
+    }
+    {
+      // 数値の項目の型が不正
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_FALSE(VLMSolverServer::ParseRequest("{\"board\":\"hh\",\"depth\":\"deep\"}", default_search, &request, &error_message));
+      ASSERT_EQ(0, error_message.find("invalid parameter"));
+    }
+    {
+      // 探索深さが範囲外
+      VLMSolverServer::SolveRequest request;
+      string error_message;
+
+      ASSERT_FALSE(VLMSolverServer::ParseRequest("{\"board\":\"hh\",\"depth\":0}", default_search, &request, &error_message));
+      ASSERT_EQ("depth is out of range", error_message);
+    }
+  }
+};
+
+TEST_F(VLMSolverServerTest, ParseValidRequestTest)
+{
+  ParseValidRequestTest();
+}
+
+TEST_F(VLMSolverServerTest, ParseInvalidRequestTest)
+{
+  ParseInvalidRequestTest();
+}